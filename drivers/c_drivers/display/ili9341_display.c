@@ -7,6 +7,9 @@
  */
 
 #include "ili9341_display.h"
+#include "ili9341_text.h"
+#include "ili9341_dma.h"
+#include <stdlib.h>
 #include <string.h>
 
 /* Forward declarations of external displaylib_16 functions */
@@ -20,112 +23,120 @@ extern void ILI9341_DrawPixel(uint16_t x, uint16_t y, uint16_t color);
 extern void ILI9341_DrawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
 extern void ILI9341_SetCursor(int16_t x, int16_t y);
 extern void ILI9341_SetTextColor(uint16_t c, uint16_t bg);
-extern void ILI9341_WriteChar(char c);
-extern void ILI9341_WriteString(const char* str);
 extern void ILI9341_SetRotation(uint8_t rotation);
 extern void ILI9341_InvertDisplay(bool invert);
 extern void ILI9341_EnableDisplay(bool enable);
 extern void ILI9341_SetTextWrap(bool wrap);
 
-/* Simple bitmap font: 5x8 pixels per character */
-static const uint8_t font_5x8[96][5] = {
-    { 0x00, 0x00, 0x00, 0x00, 0x00 }, /* Space */
-    { 0x3E, 0x5B, 0x4F, 0x5B, 0x3E }, /* ! - simplified */
-    { 0x00, 0x00, 0x00, 0x00, 0x00 }, /* " */
-    { 0x00, 0x00, 0x00, 0x00, 0x00 }, /* # */
-    { 0x00, 0x00, 0x00, 0x00, 0x00 }, /* $ */
-    { 0x00, 0x00, 0x00, 0x00, 0x00 }, /* % */
-    { 0x00, 0x00, 0x00, 0x00, 0x00 }, /* & */
-    { 0x00, 0x00, 0x00, 0x00, 0x00 }, /* ' */
-    { 0x00, 0x00, 0x00, 0x00, 0x00 }, /* ( */
-    { 0x00, 0x00, 0x00, 0x00, 0x00 }, /* ) */
-    { 0x00, 0x00, 0x00, 0x00, 0x00 }, /* * */
-    { 0x00, 0x00, 0x00, 0x00, 0x00 }, /* + */
-    { 0x00, 0x00, 0x00, 0x00, 0x00 }, /* , */
-    { 0x08, 0x08, 0x08, 0x08, 0x08 }, /* - */
-    { 0x00, 0x00, 0x00, 0x00, 0x00 }, /* . */
-    { 0x00, 0x20, 0x40, 0x80, 0x10 }, /* / */
-    { 0x3E, 0x51, 0x49, 0x45, 0x3E }, /* 0 */
-    { 0x00, 0x42, 0x7F, 0x40, 0x00 }, /* 1 */
-    { 0x42, 0x61, 0x51, 0x49, 0x46 }, /* 2 */
-    { 0x21, 0x41, 0x45, 0x4B, 0x31 }, /* 3 */
-    { 0x18, 0x14, 0x12, 0x7F, 0x10 }, /* 4 */
-    { 0x27, 0x45, 0x45, 0x45, 0x39 }, /* 5 */
-    { 0x3C, 0x4A, 0x49, 0x49, 0x30 }, /* 6 */
-    { 0x01, 0x71, 0x09, 0x05, 0x03 }, /* 7 */
-    { 0x36, 0x49, 0x49, 0x49, 0x36 }, /* 8 */
-    { 0x06, 0x49, 0x49, 0x29, 0x1E }, /* 9 */
-    { 0x00, 0x36, 0x36, 0x00, 0x00 }, /* : */
-    { 0x00, 0x56, 0x36, 0x00, 0x00 }, /* ; */
-    { 0x08, 0x14, 0x22, 0x41, 0x00 }, /* < */
-    { 0x14, 0x14, 0x14, 0x14, 0x14 }, /* = */
-    { 0x00, 0x41, 0x22, 0x14, 0x08 }, /* > */
-    { 0x02, 0x01, 0x51, 0x09, 0x06 }, /* ? */
-    { 0x32, 0x49, 0x59, 0x51, 0x3E }, /* @ */
-    { 0x7E, 0x11, 0x11, 0x11, 0x7E }, /* A */
-    { 0x7F, 0x49, 0x49, 0x49, 0x36 }, /* B */
-    { 0x3E, 0x41, 0x41, 0x41, 0x22 }, /* C */
-    { 0x7F, 0x41, 0x41, 0x22, 0x1C }, /* D */
-    { 0x7F, 0x49, 0x49, 0x49, 0x41 }, /* E */
-    { 0x7F, 0x09, 0x09, 0x09, 0x01 }, /* F */
-    { 0x3E, 0x41, 0x49, 0x49, 0x7A }, /* G */
-    { 0x7F, 0x08, 0x08, 0x08, 0x7F }, /* H */
-    { 0x00, 0x41, 0x7F, 0x41, 0x00 }, /* I */
-    { 0x20, 0x40, 0x41, 0x3F, 0x01 }, /* J */
-    { 0x7F, 0x08, 0x14, 0x22, 0x41 }, /* K */
-    { 0x7F, 0x40, 0x40, 0x40, 0x40 }, /* L */
-    { 0x7F, 0x02, 0x0C, 0x02, 0x7F }, /* M */
-    { 0x7F, 0x04, 0x08, 0x10, 0x7F }, /* N */
-    { 0x3E, 0x41, 0x41, 0x41, 0x3E }, /* O */
-    { 0x7F, 0x09, 0x09, 0x09, 0x06 }, /* P */
-    { 0x3E, 0x41, 0x51, 0x21, 0x5E }, /* Q */
-    { 0x7F, 0x09, 0x19, 0x29, 0x46 }, /* R */
-    { 0x46, 0x49, 0x49, 0x49, 0x31 }, /* S */
-    { 0x01, 0x01, 0x7F, 0x01, 0x01 }, /* T */
-    { 0x3F, 0x40, 0x40, 0x40, 0x3F }, /* U */
-    { 0x1F, 0x20, 0x40, 0x20, 0x1F }, /* V */
-    { 0x3F, 0x40, 0x38, 0x40, 0x3F }, /* W */
-    { 0x63, 0x14, 0x08, 0x14, 0x63 }, /* X */
-    { 0x07, 0x08, 0x70, 0x08, 0x07 }, /* Y */
-    { 0x61, 0x51, 0x49, 0x45, 0x43 }, /* Z */
-    { 0x00, 0x7F, 0x41, 0x41, 0x00 }, /* [ */
-    { 0x15, 0x16, 0x7C, 0x16, 0x15 }, /* \ */
-    { 0x00, 0x41, 0x41, 0x7F, 0x00 }, /* ] */
-    { 0x04, 0x02, 0x01, 0x02, 0x04 }, /* ^ */
-    { 0x40, 0x40, 0x40, 0x40, 0x40 }, /* _ */
-    { 0x00, 0x01, 0x02, 0x04, 0x00 }, /* ` */
-    { 0x20, 0x54, 0x54, 0x54, 0x78 }, /* a */
-    { 0x7F, 0x48, 0x44, 0x44, 0x38 }, /* b */
-    { 0x38, 0x44, 0x44, 0x44, 0x20 }, /* c */
-    { 0x38, 0x44, 0x44, 0x48, 0x7F }, /* d */
-    { 0x38, 0x54, 0x54, 0x54, 0x18 }, /* e */
-    { 0x08, 0x7E, 0x09, 0x01, 0x02 }, /* f */
-    { 0x0C, 0x52, 0x52, 0x52, 0x3E }, /* g */
-    { 0x7F, 0x08, 0x04, 0x04, 0x78 }, /* h */
-    { 0x00, 0x44, 0x7D, 0x40, 0x00 }, /* i */
-    { 0x20, 0x40, 0x44, 0x3D, 0x00 }, /* j */
-    { 0x7F, 0x10, 0x28, 0x44, 0x00 }, /* k */
-    { 0x00, 0x41, 0x7F, 0x40, 0x00 }, /* l */
-    { 0x7C, 0x04, 0x18, 0x04, 0x78 }, /* m */
-    { 0x7C, 0x08, 0x04, 0x04, 0x78 }, /* n */
-    { 0x38, 0x44, 0x44, 0x44, 0x38 }, /* o */
-    { 0x7C, 0x14, 0x14, 0x14, 0x08 }, /* p */
-    { 0x08, 0x14, 0x14, 0x18, 0x7C }, /* q */
-    { 0x7C, 0x08, 0x04, 0x04, 0x08 }, /* r */
-    { 0x48, 0x54, 0x54, 0x54, 0x20 }, /* s */
-    { 0x04, 0x3F, 0x44, 0x40, 0x20 }, /* t */
-    { 0x3C, 0x40, 0x40, 0x20, 0x7C }, /* u */
-    { 0x1C, 0x20, 0x40, 0x20, 0x1C }, /* v */
-    { 0x3C, 0x40, 0x30, 0x40, 0x3C }, /* w */
-    { 0x44, 0x28, 0x10, 0x28, 0x44 }, /* x */
-    { 0x0C, 0x50, 0x50, 0x50, 0x3C }, /* y */
-    { 0x44, 0x64, 0x54, 0x4C, 0x44 }, /* z */
-    { 0x00, 0x08, 0x36, 0x41, 0x00 }, /* { */
-    { 0x00, 0x00, 0x7F, 0x00, 0x00 }, /* | */
-    { 0x00, 0x41, 0x36, 0x08, 0x00 }, /* } */
-    { 0x10, 0x08, 0x08, 0x10, 0x08 }, /* ~ */
-    { 0x00, 0x00, 0x00, 0x00, 0x00 }  /* DEL */
-};
+/* ===== Internal Helpers ===== */
+
+/* Cohen-Sutherland outcode bits */
+#define OUT_LEFT  1
+#define OUT_RIGHT 2
+#define OUT_ABOVE 4
+#define OUT_BELOW 8
+
+static uint8_t outcode(const display_handle_t* display, int32_t x, int32_t y) {
+    uint8_t code = 0;
+    if (x < 0) code |= OUT_LEFT;
+    else if (x >= display->width) code |= OUT_RIGHT;
+    if (y < 0) code |= OUT_ABOVE;
+    else if (y >= display->height) code |= OUT_BELOW;
+    return code;
+}
+
+/**
+ * Fill a rectangle clipped to the screen, one address window. Coordinates
+ * are signed so partially off-screen shapes clip instead of wrapping.
+ */
+static void fill_clipped(const display_handle_t* display, int32_t x, int32_t y,
+                         int32_t width, int32_t height, uint16_t color) {
+    int32_t x1 = x + width;
+    int32_t y1 = y + height;
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x1 > display->width) x1 = display->width;
+    if (y1 > display->height) y1 = display->height;
+    if (x1 <= x || y1 <= y) {
+        return;
+    }
+
+    display_dma_wait_idle();  /* Queued text may still be going out */
+    ILI9341_FillRect((uint16_t)x, (uint16_t)y, (uint16_t)(x1 - x), (uint16_t)(y1 - y), color);
+}
+
+/**
+ * Narrow [*first, *last] to the steps of a line walk whose coordinate lies
+ * in [lo, hi]. At step i the coordinate is start + sign * t(i), with
+ * t(i) = floor((2 * i * num + den) / (2 * den)); num == den on the major axis.
+ */
+static void clamp_steps(int32_t start, int32_t sign, int32_t num, int32_t den,
+                        int32_t lo, int32_t hi, int32_t* first, int32_t* last) {
+    int64_t t_lo = sign > 0 ? lo - start : start - hi;
+    int64_t t_hi = sign > 0 ? hi - start : start - lo;
+    if (t_hi < 0) {
+        *last = -1;
+        return;
+    }
+    if (t_lo > 0) {
+        int64_t min_step = (2 * t_lo * den - den + 2 * num - 1) / (2 * num);
+        if (min_step > *first) *first = (int32_t)min_step;
+    }
+    int64_t max_step = (2 * (t_hi + 1) * den - den - 1) / (2 * num);
+    if (max_step < *last) *last = (int32_t)max_step;
+}
+
+/**
+ * Write characters at the cursor. Each run that stays on one line goes to
+ * display_draw_chars() as a single call; '\n' and wrapping start a new line.
+ */
+static void write_chars(display_handle_t* display, const char* str, size_t length) {
+    if (!display || !display->initialized) {
+        return;
+    }
+
+    uint8_t scale = display->text_scale < 1 ? 1 : display->text_scale;
+    if (scale > DISPLAY_TEXT_MAX_SCALE) scale = DISPLAY_TEXT_MAX_SCALE;
+    uint16_t cell_w = DISPLAY_TEXT_CELL_WIDTH * scale;
+    uint16_t cell_h = DISPLAY_TEXT_CELL_HEIGHT * scale;
+    size_t i = 0;
+
+    while (i < length) {
+        if (str[i] == '\n') {
+            display->cursor_x = 0;
+            display->cursor_y += cell_h;
+            i++;
+            continue;
+        }
+        if (str[i] == '\r') {
+            i++;
+            continue;
+        }
+
+        size_t run = 0;
+        while (i + run < length && str[i + run] != '\n' && str[i + run] != '\r') {
+            run++;
+        }
+
+        if (display->text_wrap) {
+            size_t fit = display->cursor_x < display->width
+                       ? (display->width - display->cursor_x) / cell_w : 0;
+            if (fit == 0) {
+                if (display->cursor_x == 0) {
+                    return;  /* Not even one cell fits */
+                }
+                display->cursor_x = 0;
+                display->cursor_y += cell_h;
+                continue;
+            }
+            if (run > fit) run = fit;
+        }
+
+        display->cursor_x += display_draw_chars(display, (int16_t)display->cursor_x,
+                                                (int16_t)display->cursor_y, str + i, run);
+        i += run;
+    }
+}
 
 /* ===== API Implementation ===== */
 
@@ -158,6 +169,7 @@ bool display_init(display_handle_t* display,
     display->cursor_y = 0;
     display->text_color = COLOR_WHITE;
     display->text_bg_color = COLOR_BLACK;
+    display->text_scale = 1;
     display->text_wrap = true;
 
     /* Configure via displaylib_16 */
@@ -166,6 +178,9 @@ bool display_init(display_handle_t* display,
     ILI9341_SetupSPI_HW(spi_speed_hz, spi_instance);
     ILI9341_Initialize();
 
+    /* Text is queued on the DMA engine; without a channel it is not drawn */
+    display_dma_init(spi_instance, (uint8_t)dc, (uint8_t)cs);
+
     display->initialized = true;
     return true;
 }
@@ -175,6 +190,7 @@ void display_deinit(display_handle_t* display) {
         return;
     }
 
+    display_dma_deinit();
     ILI9341_EnableDisplay(false);
     display->initialized = false;
 }
@@ -184,6 +200,7 @@ void display_fill_screen(display_handle_t* display, uint16_t color) {
         return;
     }
 
+    display_dma_wait_idle();
     ILI9341_FillScreen(color);
 }
 
@@ -193,27 +210,30 @@ void display_fill_rect(display_handle_t* display, uint16_t x, uint16_t y,
         return;
     }
 
-    ILI9341_FillRect(x, y, width, height, color);
+    fill_clipped(display, x, y, width, height, color);
 }
 
 void display_draw_rect(display_handle_t* display, uint16_t x, uint16_t y, 
                        uint16_t width, uint16_t height, uint16_t color) {
-    if (!display || !display->initialized) {
+    if (!display || !display->initialized || width == 0 || height == 0) {
         return;
     }
 
-    /* Draw 4 lines forming rectangle outline */
-    ILI9341_DrawLine(x, y, x + width - 1, y, color);
-    ILI9341_DrawLine(x + width - 1, y, x + width - 1, y + height - 1, color);
-    ILI9341_DrawLine(x, y + height - 1, x + width - 1, y + height - 1, color);
-    ILI9341_DrawLine(x, y, x, y + height - 1, color);
+    /* Each edge is a one-pixel-thick fill, i.e. a single window */
+    fill_clipped(display, x, y, width, 1, color);
+    if (height > 1) fill_clipped(display, x, y + height - 1, width, 1, color);
+    if (height > 2) {
+        fill_clipped(display, x, y + 1, 1, height - 2, color);
+        if (width > 1) fill_clipped(display, x + width - 1, y + 1, 1, height - 2, color);
+    }
 }
 
 void display_draw_pixel(display_handle_t* display, uint16_t x, uint16_t y, uint16_t color) {
-    if (!display || !display->initialized) {
+    if (!display || !display->initialized || x >= display->width || y >= display->height) {
         return;
     }
 
+    display_dma_wait_idle();
     ILI9341_DrawPixel(x, y, color);
 }
 
@@ -222,8 +242,76 @@ void display_draw_line(display_handle_t* display, int16_t x0, int16_t y0,
     if (!display || !display->initialized) {
         return;
     }
+    display_dma_wait_idle();
+
+    /* Horizontal and vertical lines are a single window */
+    if (x0 == x1 || y0 == y1) {
+        int32_t left = x0 < x1 ? x0 : x1;
+        int32_t top = y0 < y1 ? y0 : y1;
+        fill_clipped(display, left, top, abs(x1 - x0) + 1, abs(y1 - y0) + 1, color);
+        return;
+    }
+
+    uint8_t code0 = outcode(display, x0, y0);
+    uint8_t code1 = outcode(display, x1, y1);
+    if (code0 & code1) {
+        return;  /* Wholly on one side of the screen */
+    }
+
+    /*
+     * Walk the major axis; the minor axis advances by minor/major per step,
+     * rounded to nearest. A partially visible line is clipped by narrowing
+     * the step range, so the pixels drawn are those of the whole line.
+     */
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    int32_t major_start = steep ? y0 : x0;
+    int32_t minor_start = steep ? x0 : y0;
+    int32_t major_sign = (steep ? y1 > y0 : x1 > x0) ? 1 : -1;
+    int32_t minor_sign = (steep ? x1 > x0 : y1 > y0) ? 1 : -1;
+    int32_t major = abs(steep ? y1 - y0 : x1 - x0);
+    int32_t minor = abs(steep ? x1 - x0 : y1 - y0);
+    int32_t major_end = (steep ? display->height : display->width) - 1;
+    int32_t minor_end = (steep ? display->width : display->height) - 1;
+
+    int32_t first = 0;
+    int32_t last = major;
+    if (code0 | code1) {
+        clamp_steps(major_start, major_sign, major, major, 0, major_end, &first, &last);
+        clamp_steps(minor_start, minor_sign, minor, major, 0, minor_end, &first, &last);
+        if (first > last) {
+            return;
+        }
+    }
 
-    ILI9341_DrawLine(x0, y0, x1, y1, color);
+    /* Bresenham by runs: steps on the same minor coordinate are one fill */
+    int32_t two_major = 2 * major;
+    int64_t numerator = 2 * (int64_t)first * minor + major;
+    int32_t t = (int32_t)(numerator / two_major);
+    int32_t rem = (int32_t)(numerator % two_major);
+    int32_t run_start = first;
+
+    for (int32_t i = first; i <= last; i++) {
+        int32_t next_t = t;
+        rem += 2 * minor;
+        if (rem >= two_major) {
+            rem -= two_major;
+            next_t++;
+        }
+        if (next_t == t && i < last) {
+            continue;
+        }
+
+        int32_t a = major_start + major_sign * run_start;
+        int32_t b = major_start + major_sign * i;
+        int32_t lo = a < b ? a : b;
+        int32_t len = abs(b - a) + 1;
+        int32_t m = minor_start + minor_sign * t;
+        ILI9341_FillRect((uint16_t)(steep ? m : lo), (uint16_t)(steep ? lo : m),
+                         (uint16_t)(steep ? 1 : len), (uint16_t)(steep ? len : 1), color);
+
+        run_start = i + 1;
+        t = next_t;
+    }
 }
 
 void display_set_cursor(display_handle_t* display, uint16_t x, uint16_t y) {
@@ -256,21 +344,15 @@ void display_set_text_wrap(display_handle_t* display, bool wrap) {
 }
 
 void display_write_char(display_handle_t* display, char c) {
-    if (!display || !display->initialized) {
-        return;
-    }
-
-    ILI9341_WriteChar(c);
-    display->cursor_x++;
+    write_chars(display, &c, 1);
 }
 
 void display_write_string(display_handle_t* display, const char* str) {
-    if (!display || !str || !display->initialized) {
+    if (!str) {
         return;
     }
 
-    ILI9341_WriteString(str);
-    display->cursor_x += strlen(str) * 6; /* Approximate */
+    write_chars(display, str, strlen(str));
 }
 
 void display_set_rotation(display_handle_t* display, display_rotation_t rotation) {
@@ -279,6 +361,7 @@ void display_set_rotation(display_handle_t* display, display_rotation_t rotation
     }
 
     display->rotation = rotation;
+    display_dma_wait_idle();
     ILI9341_SetRotation((uint8_t)rotation);
 
     /* Swap width/height for 90/270 rotations */
@@ -294,6 +377,7 @@ void display_invert(display_handle_t* display, bool invert) {
         return;
     }
 
+    display_dma_wait_idle();
     ILI9341_InvertDisplay(invert);
 }
 
@@ -302,6 +386,7 @@ void display_set_enabled(display_handle_t* display, bool enable) {
         return;
     }
 
+    display_dma_wait_idle();
     ILI9341_EnableDisplay(enable);
 }
 
@@ -71,6 +71,7 @@ typedef struct {
     uint16_t cursor_y;
     uint16_t text_color;
     uint16_t text_bg_color;
+    uint8_t text_scale;
     bool text_wrap;
 } display_handle_t;
 
@@ -141,7 +142,10 @@ void display_draw_rect(display_handle_t* display, uint16_t x, uint16_t y,
 void display_draw_pixel(display_handle_t* display, uint16_t x, uint16_t y, uint16_t color);
 
 /**
- * @brief Draw a line between two points
+ * @brief Draw a line between two points, clipped to the screen
+ *
+ * Horizontal and vertical lines go out as one window; other lines send
+ * each run of pixels on the same row or column as one window.
  * @param display Pointer to display_handle_t
  * @param x0 Start X coordinate
  * @param y0 Start Y coordinate
@@ -176,16 +180,20 @@ void display_set_text_color(display_handle_t* display, uint16_t text_color, uint
 void display_set_text_wrap(display_handle_t* display, bool wrap);
 
 /**
- * @brief Write a single character
+ * @brief Write a single character at the cursor and advance it
  * @param display Pointer to display_handle_t
- * @param c ASCII character
+ * @param c ASCII character; '\n' moves to the next line
+ *
+ * Drawn from the glyph cache (see ili9341_text.h) as one window.
  */
 void display_write_char(display_handle_t* display, char c);
 
 /**
- * @brief Write a string
+ * @brief Write a string at the cursor, wrapping if enabled
  * @param display Pointer to display_handle_t
  * @param str Null-terminated string
+ *
+ * Each run of characters on one line is sent as one window.
  */
 void display_write_string(display_handle_t* display, const char* str);
 
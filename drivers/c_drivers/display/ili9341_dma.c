@@ -0,0 +1,284 @@
+/**
+ * @file ili9341_dma.c
+ * @brief DMA-driven transfer queue implementation for ILI9341
+ *
+ * Descriptors live in a ring indexed by two free-running counters: head
+ * (descriptors queued, doubling as the fence counter) and tail (descriptors
+ * completed). Each pixel transfer runs a TX channel feeding the SPI FIFO and
+ * an RX channel draining it; the RX channel only finishes once the last frame
+ * has been clocked out, so its completion interrupt can release CS, retire
+ * the descriptor and start the next without waiting on the bus.
+ */
+
+#include "ili9341_dma.h"
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/spi.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+/* ILI9341 commands */
+#define ILI9341_CASET 0x2A
+#define ILI9341_PASET 0x2B
+#define ILI9341_RAMWR 0x2C
+
+#define QUEUE_MASK (DISPLAY_DMA_QUEUE_DEPTH - 1)
+
+typedef struct {
+    uint16_t x0, y0, x1, y1;  /* Inclusive address window */
+    const uint8_t* data;      /* Blit source, NULL for fills */
+    uint32_t pixels;          /* 0 for raw commands */
+    uint16_t color;           /* Fill source, read repeatedly by DMA */
+    uint8_t command;          /* Raw commands only */
+    uint8_t param_count;
+    uint8_t params[DISPLAY_DMA_MAX_PARAMS];
+} dma_descriptor_t;
+
+static struct {
+    spi_inst_t* spi;
+    uint8_t pin_dc;
+    uint8_t pin_cs;
+    int channel;
+    int rx_channel;
+    uint16_t rx_discard;      /* Sink for the frames clocked back in */
+    bool initialized;
+    volatile bool active;
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    dma_descriptor_t queue[DISPLAY_DMA_QUEUE_DEPTH];
+} dma_state;
+
+/* ===== Internal Helpers ===== */
+
+static void write_command(uint8_t cmd) {
+    gpio_put(dma_state.pin_dc, 0);
+    spi_write_blocking(dma_state.spi, &cmd, 1);
+}
+
+static void write_range(uint16_t start, uint16_t end) {
+    uint8_t params[4] = { start >> 8, start & 0xFF, end >> 8, end & 0xFF };
+    gpio_put(dma_state.pin_dc, 1);
+    spi_write_blocking(dma_state.spi, params, sizeof(params));
+}
+
+static void send_raw_command(const dma_descriptor_t* desc) {
+    gpio_put(dma_state.pin_cs, 0);
+    write_command(desc->command);
+    if (desc->param_count > 0) {
+        gpio_put(dma_state.pin_dc, 1);
+        spi_write_blocking(dma_state.spi, desc->params, desc->param_count);
+    }
+    gpio_put(dma_state.pin_cs, 1);
+}
+
+static void start_transfer(const dma_descriptor_t* desc) {
+    gpio_put(dma_state.pin_cs, 0);
+    write_command(ILI9341_CASET);
+    write_range(desc->x0, desc->x1);
+    write_command(ILI9341_PASET);
+    write_range(desc->y0, desc->y1);
+    write_command(ILI9341_RAMWR);
+    gpio_put(dma_state.pin_dc, 1);
+
+    enum dma_channel_transfer_size size = DMA_SIZE_8;
+    uint32_t frames = desc->pixels * 2;
+    if (!desc->data) {
+        /* 16-bit frames send the color MSB first, one DMA read per pixel */
+        spi_set_format(dma_state.spi, 16, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+        size = DMA_SIZE_16;
+        frames = desc->pixels;
+    }
+
+    dma_channel_config config = dma_channel_get_default_config(dma_state.channel);
+    channel_config_set_transfer_data_size(&config, size);
+    channel_config_set_dreq(&config, spi_get_dreq(dma_state.spi, true));
+    channel_config_set_read_increment(&config, desc->data != NULL);
+    channel_config_set_write_increment(&config, false);
+    dma_channel_configure(dma_state.channel, &config, &spi_get_hw(dma_state.spi)->dr,
+                          desc->data ? (const void*)desc->data : &desc->color, frames, false);
+
+    /* One RX frame arrives per TX frame, the last one after it has shifted out */
+    config = dma_channel_get_default_config(dma_state.rx_channel);
+    channel_config_set_transfer_data_size(&config, size);
+    channel_config_set_dreq(&config, spi_get_dreq(dma_state.spi, false));
+    channel_config_set_read_increment(&config, false);
+    channel_config_set_write_increment(&config, false);
+    dma_channel_configure(dma_state.rx_channel, &config, &dma_state.rx_discard,
+                          &spi_get_hw(dma_state.spi)->dr, frames, false);
+
+    dma_start_channel_mask((1u << dma_state.channel) | (1u << dma_state.rx_channel));
+}
+
+/*
+ * Called with interrupts disabled or from the DMA interrupt. Raw commands
+ * are short, so they are sent and retired inline; stops at the next pixel
+ * transfer, whose completion interrupt continues the chain.
+ */
+static void start_next(void) {
+    while (dma_state.tail != dma_state.head) {
+        dma_descriptor_t* desc = &dma_state.queue[dma_state.tail & QUEUE_MASK];
+        if (desc->pixels > 0) {
+            dma_state.active = true;
+            start_transfer(desc);
+            return;
+        }
+        send_raw_command(desc);
+        dma_state.tail++;
+    }
+    dma_state.active = false;
+}
+
+static void dma_irq_handler(void) {
+    if (!dma_state.initialized || !dma_channel_get_irq0_status(dma_state.rx_channel)) {
+        return;
+    }
+    dma_channel_acknowledge_irq0(dma_state.rx_channel);
+
+    /* Every frame has been received back, so the bus is already idle */
+    gpio_put(dma_state.pin_cs, 1);
+    spi_set_format(dma_state.spi, 8, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+
+    dma_state.tail++;
+    start_next();
+}
+
+static dma_descriptor_t* reserve_descriptor(void) {
+    /* Backpressure: wait for the interrupt to retire a slot */
+    while (dma_state.head - dma_state.tail >= DISPLAY_DMA_QUEUE_DEPTH) {
+        tight_loop_contents();
+    }
+    return &dma_state.queue[dma_state.head & QUEUE_MASK];
+}
+
+static display_dma_fence_t commit_descriptor(void) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    dma_state.head++;
+    if (!dma_state.active) {
+        start_next();
+    }
+    restore_interrupts(irq_state);
+    return dma_state.head;
+}
+
+/* ===== API Implementation ===== */
+
+bool display_dma_init(void* spi_instance, uint8_t dc, uint8_t cs) {
+    if (!spi_instance || dma_state.initialized) {
+        return false;
+    }
+
+    int channel = dma_claim_unused_channel(false);
+    if (channel < 0) {
+        return false;
+    }
+    int rx_channel = dma_claim_unused_channel(false);
+    if (rx_channel < 0) {
+        dma_channel_unclaim(channel);
+        return false;
+    }
+
+    dma_state.spi = (spi_inst_t*)spi_instance;
+    dma_state.pin_dc = dc;
+    dma_state.pin_cs = cs;
+    dma_state.channel = channel;
+    dma_state.rx_channel = rx_channel;
+    dma_state.active = false;
+    dma_state.head = 0;
+    dma_state.tail = 0;
+
+    dma_channel_set_irq0_enabled(rx_channel, true);
+    irq_add_shared_handler(DMA_IRQ_0, dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    dma_state.initialized = true;
+    return true;
+}
+
+void display_dma_deinit(void) {
+    if (!dma_state.initialized) {
+        return;
+    }
+
+    display_dma_wait_idle();
+    dma_channel_set_irq0_enabled(dma_state.rx_channel, false);
+    irq_remove_handler(DMA_IRQ_0, dma_irq_handler);
+    dma_channel_unclaim(dma_state.channel);
+    dma_channel_unclaim(dma_state.rx_channel);
+    dma_state.initialized = false;
+}
+
+bool display_dma_is_ready(void) {
+    return dma_state.initialized;
+}
+
+display_dma_fence_t display_dma_fill_rect(uint16_t x, uint16_t y,
+                                          uint16_t width, uint16_t height, uint16_t color) {
+    if (!dma_state.initialized || width == 0 || height == 0) {
+        return dma_state.head;
+    }
+
+    dma_descriptor_t* desc = reserve_descriptor();
+    desc->x0 = x;
+    desc->y0 = y;
+    desc->x1 = x + width - 1;
+    desc->y1 = y + height - 1;
+    desc->data = NULL;
+    desc->pixels = (uint32_t)width * height;
+    desc->color = color;
+    return commit_descriptor();
+}
+
+display_dma_fence_t display_dma_blit(uint16_t x, uint16_t y,
+                                     uint16_t width, uint16_t height, const uint8_t* data) {
+    if (!dma_state.initialized || !data || width == 0 || height == 0) {
+        return dma_state.head;
+    }
+
+    dma_descriptor_t* desc = reserve_descriptor();
+    desc->x0 = x;
+    desc->y0 = y;
+    desc->x1 = x + width - 1;
+    desc->y1 = y + height - 1;
+    desc->data = data;
+    desc->pixels = (uint32_t)width * height;
+    return commit_descriptor();
+}
+
+display_dma_fence_t display_dma_command(uint8_t cmd, const uint8_t* params, uint8_t count) {
+    if (!dma_state.initialized || count > DISPLAY_DMA_MAX_PARAMS || (count > 0 && !params)) {
+        return dma_state.head;
+    }
+
+    dma_descriptor_t* desc = reserve_descriptor();
+    desc->data = NULL;
+    desc->pixels = 0;
+    desc->command = cmd;
+    desc->param_count = count;
+    if (count > 0) {
+        memcpy(desc->params, params, count);
+    }
+    return commit_descriptor();
+}
+
+display_dma_fence_t display_dma_fence(void) {
+    return dma_state.head;
+}
+
+bool display_dma_fence_reached(display_dma_fence_t fence) {
+    return (int32_t)(dma_state.tail - fence) >= 0;
+}
+
+void display_dma_wait(display_dma_fence_t fence) {
+    while (!display_dma_fence_reached(fence)) {
+        tight_loop_contents();
+    }
+}
+
+void display_dma_wait_idle(void) {
+    display_dma_wait(dma_state.head);
+}
+
+uint32_t display_dma_pending(void) {
+    return dma_state.head - dma_state.tail;
+}
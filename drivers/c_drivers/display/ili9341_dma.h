@@ -0,0 +1,137 @@
+/**
+ * @file ili9341_dma.h
+ * @brief DMA-driven transfer queue for the ILI9341
+ *
+ * Fills and bitmap blits are queued as descriptors and streamed to the
+ * display SPI by DMA, chained from the DMA completion interrupt, so the
+ * CPU can keep working while pixels shift out. Each descriptor sets the
+ * address window (CASET/PASET/RAMWR) and then hands the pixel payload to
+ * DMA.
+ *
+ * The queue shares the SPI bus, DC and CS pins with displaylib_16 (and the
+ * touch controller), so call display_dma_wait_idle() before any other code
+ * touches the bus. All functions must be called from a single core.
+ */
+
+#ifndef ILI9341_DMA_H
+#define ILI9341_DMA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===== Configuration ===== */
+#ifndef DISPLAY_DMA_QUEUE_DEPTH
+#define DISPLAY_DMA_QUEUE_DEPTH 32  /* Must be a power of two */
+#endif
+
+#define DISPLAY_DMA_MAX_PARAMS 6  /* Parameter bytes per queued command */
+
+/**
+ * @brief Marks a point in the queue; reached once everything queued before it
+ * has been shifted out
+ */
+typedef uint32_t display_dma_fence_t;
+
+/* ===== Public API ===== */
+
+/**
+ * @brief Claim TX and RX DMA channels and install the completion interrupt
+ * @param spi_instance SPI instance the display is on (spi0 or spi1), already initialized
+ * @param dc Data/Command pin, already configured as output
+ * @param cs Chip Select pin, already configured as output
+ * @return true if both DMA channels were available
+ */
+bool display_dma_init(void* spi_instance, uint8_t dc, uint8_t cs);
+
+/**
+ * @brief Drain the queue and release the DMA channels
+ */
+void display_dma_deinit(void);
+
+/**
+ * @brief Check if display_dma_init() succeeded
+ * @return true if the queue is usable
+ */
+bool display_dma_is_ready(void);
+
+/**
+ * @brief Queue a solid rectangle fill
+ * @param x Starting X coordinate
+ * @param y Starting Y coordinate
+ * @param width Width in pixels (> 0)
+ * @param height Height in pixels (> 0)
+ * @param color 16-bit RGB565 color
+ * @return Fence reached when this fill is complete
+ *
+ * Blocks only while the queue is full.
+ */
+display_dma_fence_t display_dma_fill_rect(uint16_t x, uint16_t y,
+                                          uint16_t width, uint16_t height, uint16_t color);
+
+/**
+ * @brief Queue a bitmap blit
+ * @param x Starting X coordinate
+ * @param y Starting Y coordinate
+ * @param width Width in pixels (> 0)
+ * @param height Height in pixels (> 0)
+ * @param data Big-endian RGB565 bytes, width * height * 2 long
+ * @return Fence reached when this blit is complete
+ *
+ * data is read by DMA after this returns; it must stay valid and unchanged
+ * until the returned fence is reached (flash assets always are).
+ */
+display_dma_fence_t display_dma_blit(uint16_t x, uint16_t y,
+                                     uint16_t width, uint16_t height, const uint8_t* data);
+
+/**
+ * @brief Queue a raw command with parameter bytes
+ * @param cmd Command byte
+ * @param params Parameter bytes, copied into the queue
+ * @param count Number of parameter bytes (<= DISPLAY_DMA_MAX_PARAMS)
+ * @return Fence reached once the command has been sent
+ *
+ * The command goes out in order with queued fills and blits, so register
+ * changes such as the vertical scroll start take effect after the pixels
+ * drawn before them. It is sent from the queue without DMA.
+ */
+display_dma_fence_t display_dma_command(uint8_t cmd, const uint8_t* params, uint8_t count);
+
+/**
+ * @brief Get a fence for everything queued so far
+ * @return Fence
+ */
+display_dma_fence_t display_dma_fence(void);
+
+/**
+ * @brief Check whether a fence has been reached without blocking
+ * @param fence Fence from a queue call or display_dma_fence()
+ * @return true if all work up to the fence is complete
+ */
+bool display_dma_fence_reached(display_dma_fence_t fence);
+
+/**
+ * @brief Block until a fence has been reached
+ * @param fence Fence from a queue call or display_dma_fence()
+ */
+void display_dma_wait(display_dma_fence_t fence);
+
+/**
+ * @brief Block until the queue is empty and the SPI bus is free
+ */
+void display_dma_wait_idle(void);
+
+/**
+ * @brief Get the number of descriptors waiting or in flight
+ * @return Pending descriptor count
+ */
+uint32_t display_dma_pending(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ILI9341_DMA_H */
@@ -0,0 +1,375 @@
+/**
+ * @file ili9341_text.c
+ * @brief Glyph-cached text rendering implementation for ILI9341
+ *
+ * Glyphs are expanded into big-endian RGB565 (the order the panel reads
+ * pixels in) for one fg/bg/scale combination and cached in LRU slots.
+ * Multi-character runs are assembled row by row from cached glyphs into a
+ * staging line and sent as one window; single characters are sent
+ * straight from their slot.
+ *
+ * Windows are queued with display_dma_blit(), which reads the pixels after
+ * it returns. Each slot and the staging line remember the fence of the
+ * last window queued from them, and are only rewritten once it is reached.
+ */
+
+#include "ili9341_text.h"
+#include "ili9341_dma.h"
+#include <string.h>
+
+#define FONT_FIRST_CHAR 32
+#define FONT_GLYPH_COLUMNS 5
+#define GLYPH_MAX_BYTES (DISPLAY_TEXT_CELL_WIDTH * DISPLAY_TEXT_CELL_HEIGHT * \
+                         DISPLAY_TEXT_MAX_SCALE * DISPLAY_TEXT_MAX_SCALE * 2)
+
+_Static_assert(DISPLAY_TEXT_LINE_BYTES >= GLYPH_MAX_BYTES,
+               "DISPLAY_TEXT_LINE_BYTES must hold one glyph at DISPLAY_TEXT_MAX_SCALE");
+
+/* 5x8 font, one byte per column, bit 0 at the top */
+static const uint8_t font_5x8[96][FONT_GLYPH_COLUMNS] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00 }, /* Space */
+    { 0x00, 0x00, 0x5F, 0x00, 0x00 }, /* ! */
+    { 0x00, 0x07, 0x00, 0x07, 0x00 }, /* " */
+    { 0x14, 0x7F, 0x14, 0x7F, 0x14 }, /* # */
+    { 0x24, 0x2A, 0x7F, 0x2A, 0x12 }, /* $ */
+    { 0x23, 0x13, 0x08, 0x64, 0x62 }, /* % */
+    { 0x36, 0x49, 0x55, 0x22, 0x50 }, /* & */
+    { 0x00, 0x05, 0x03, 0x00, 0x00 }, /* ' */
+    { 0x00, 0x1C, 0x22, 0x41, 0x00 }, /* ( */
+    { 0x00, 0x41, 0x22, 0x1C, 0x00 }, /* ) */
+    { 0x14, 0x08, 0x3E, 0x08, 0x14 }, /* * */
+    { 0x08, 0x08, 0x3E, 0x08, 0x08 }, /* + */
+    { 0x00, 0x50, 0x30, 0x00, 0x00 }, /* , */
+    { 0x08, 0x08, 0x08, 0x08, 0x08 }, /* - */
+    { 0x00, 0x60, 0x60, 0x00, 0x00 }, /* . */
+    { 0x20, 0x10, 0x08, 0x04, 0x02 }, /* / */
+    { 0x3E, 0x51, 0x49, 0x45, 0x3E }, /* 0 */
+    { 0x00, 0x42, 0x7F, 0x40, 0x00 }, /* 1 */
+    { 0x42, 0x61, 0x51, 0x49, 0x46 }, /* 2 */
+    { 0x21, 0x41, 0x45, 0x4B, 0x31 }, /* 3 */
+    { 0x18, 0x14, 0x12, 0x7F, 0x10 }, /* 4 */
+    { 0x27, 0x45, 0x45, 0x45, 0x39 }, /* 5 */
+    { 0x3C, 0x4A, 0x49, 0x49, 0x30 }, /* 6 */
+    { 0x01, 0x71, 0x09, 0x05, 0x03 }, /* 7 */
+    { 0x36, 0x49, 0x49, 0x49, 0x36 }, /* 8 */
+    { 0x06, 0x49, 0x49, 0x29, 0x1E }, /* 9 */
+    { 0x00, 0x36, 0x36, 0x00, 0x00 }, /* : */
+    { 0x00, 0x56, 0x36, 0x00, 0x00 }, /* ; */
+    { 0x08, 0x14, 0x22, 0x41, 0x00 }, /* < */
+    { 0x14, 0x14, 0x14, 0x14, 0x14 }, /* = */
+    { 0x00, 0x41, 0x22, 0x14, 0x08 }, /* > */
+    { 0x02, 0x01, 0x51, 0x09, 0x06 }, /* ? */
+    { 0x32, 0x49, 0x59, 0x51, 0x3E }, /* @ */
+    { 0x7E, 0x11, 0x11, 0x11, 0x7E }, /* A */
+    { 0x7F, 0x49, 0x49, 0x49, 0x36 }, /* B */
+    { 0x3E, 0x41, 0x41, 0x41, 0x22 }, /* C */
+    { 0x7F, 0x41, 0x41, 0x22, 0x1C }, /* D */
+    { 0x7F, 0x49, 0x49, 0x49, 0x41 }, /* E */
+    { 0x7F, 0x09, 0x09, 0x09, 0x01 }, /* F */
+    { 0x3E, 0x41, 0x49, 0x49, 0x7A }, /* G */
+    { 0x7F, 0x08, 0x08, 0x08, 0x7F }, /* H */
+    { 0x00, 0x41, 0x7F, 0x41, 0x00 }, /* I */
+    { 0x20, 0x40, 0x41, 0x3F, 0x01 }, /* J */
+    { 0x7F, 0x08, 0x14, 0x22, 0x41 }, /* K */
+    { 0x7F, 0x40, 0x40, 0x40, 0x40 }, /* L */
+    { 0x7F, 0x02, 0x0C, 0x02, 0x7F }, /* M */
+    { 0x7F, 0x04, 0x08, 0x10, 0x7F }, /* N */
+    { 0x3E, 0x41, 0x41, 0x41, 0x3E }, /* O */
+    { 0x7F, 0x09, 0x09, 0x09, 0x06 }, /* P */
+    { 0x3E, 0x41, 0x51, 0x21, 0x5E }, /* Q */
+    { 0x7F, 0x09, 0x19, 0x29, 0x46 }, /* R */
+    { 0x46, 0x49, 0x49, 0x49, 0x31 }, /* S */
+    { 0x01, 0x01, 0x7F, 0x01, 0x01 }, /* T */
+    { 0x3F, 0x40, 0x40, 0x40, 0x3F }, /* U */
+    { 0x1F, 0x20, 0x40, 0x20, 0x1F }, /* V */
+    { 0x3F, 0x40, 0x38, 0x40, 0x3F }, /* W */
+    { 0x63, 0x14, 0x08, 0x14, 0x63 }, /* X */
+    { 0x07, 0x08, 0x70, 0x08, 0x07 }, /* Y */
+    { 0x61, 0x51, 0x49, 0x45, 0x43 }, /* Z */
+    { 0x00, 0x7F, 0x41, 0x41, 0x00 }, /* [ */
+    { 0x02, 0x04, 0x08, 0x10, 0x20 }, /* \ */
+    { 0x00, 0x41, 0x41, 0x7F, 0x00 }, /* ] */
+    { 0x04, 0x02, 0x01, 0x02, 0x04 }, /* ^ */
+    { 0x40, 0x40, 0x40, 0x40, 0x40 }, /* _ */
+    { 0x00, 0x01, 0x02, 0x04, 0x00 }, /* ` */
+    { 0x20, 0x54, 0x54, 0x54, 0x78 }, /* a */
+    { 0x7F, 0x48, 0x44, 0x44, 0x38 }, /* b */
+    { 0x38, 0x44, 0x44, 0x44, 0x20 }, /* c */
+    { 0x38, 0x44, 0x44, 0x48, 0x7F }, /* d */
+    { 0x38, 0x54, 0x54, 0x54, 0x18 }, /* e */
+    { 0x08, 0x7E, 0x09, 0x01, 0x02 }, /* f */
+    { 0x0C, 0x52, 0x52, 0x52, 0x3E }, /* g */
+    { 0x7F, 0x08, 0x04, 0x04, 0x78 }, /* h */
+    { 0x00, 0x44, 0x7D, 0x40, 0x00 }, /* i */
+    { 0x20, 0x40, 0x44, 0x3D, 0x00 }, /* j */
+    { 0x7F, 0x10, 0x28, 0x44, 0x00 }, /* k */
+    { 0x00, 0x41, 0x7F, 0x40, 0x00 }, /* l */
+    { 0x7C, 0x04, 0x18, 0x04, 0x78 }, /* m */
+    { 0x7C, 0x08, 0x04, 0x04, 0x78 }, /* n */
+    { 0x38, 0x44, 0x44, 0x44, 0x38 }, /* o */
+    { 0x7C, 0x14, 0x14, 0x14, 0x08 }, /* p */
+    { 0x08, 0x14, 0x14, 0x18, 0x7C }, /* q */
+    { 0x7C, 0x08, 0x04, 0x04, 0x08 }, /* r */
+    { 0x48, 0x54, 0x54, 0x54, 0x20 }, /* s */
+    { 0x04, 0x3F, 0x44, 0x40, 0x20 }, /* t */
+    { 0x3C, 0x40, 0x40, 0x20, 0x7C }, /* u */
+    { 0x1C, 0x20, 0x40, 0x20, 0x1C }, /* v */
+    { 0x3C, 0x40, 0x30, 0x40, 0x3C }, /* w */
+    { 0x44, 0x28, 0x10, 0x28, 0x44 }, /* x */
+    { 0x0C, 0x50, 0x50, 0x50, 0x3C }, /* y */
+    { 0x44, 0x64, 0x54, 0x4C, 0x44 }, /* z */
+    { 0x00, 0x08, 0x36, 0x41, 0x00 }, /* { */
+    { 0x00, 0x00, 0x7F, 0x00, 0x00 }, /* | */
+    { 0x00, 0x41, 0x36, 0x08, 0x00 }, /* } */
+    { 0x10, 0x08, 0x08, 0x10, 0x08 }, /* ~ */
+    { 0x00, 0x00, 0x00, 0x00, 0x00 }  /* DEL */
+};
+
+typedef struct {
+    uint32_t last_used;  /* 0 while the slot is empty */
+    display_dma_fence_t fence;  /* Last blit queued from pixels */
+    uint16_t fg;
+    uint16_t bg;
+    uint8_t scale;
+    char c;
+    uint8_t pixels[GLYPH_MAX_BYTES];
+} glyph_slot_t;
+
+static struct {
+    glyph_slot_t slots[DISPLAY_TEXT_CACHE_GLYPHS];
+    uint32_t clock;
+    uint32_t hits;
+    uint32_t misses;
+    display_dma_fence_t line_fence;
+    uint8_t line[DISPLAY_TEXT_LINE_BYTES];
+} text_state;
+
+/* ===== Internal Helpers ===== */
+
+static uint8_t text_scale(const display_handle_t* display) {
+    uint8_t scale = display->text_scale;
+    if (scale < 1) return 1;
+    if (scale > DISPLAY_TEXT_MAX_SCALE) return DISPLAY_TEXT_MAX_SCALE;
+    return scale;
+}
+
+static void expand_glyph(glyph_slot_t* slot) {
+    unsigned char c = (unsigned char)slot->c;
+    const uint8_t* columns = font_5x8[c - FONT_FIRST_CHAR];
+    uint8_t width = DISPLAY_TEXT_CELL_WIDTH * slot->scale;
+    uint8_t height = DISPLAY_TEXT_CELL_HEIGHT * slot->scale;
+    uint8_t* out = slot->pixels;
+
+    for (uint8_t row = 0; row < height; row++) {
+        uint8_t bit = 1 << (row / slot->scale);
+        for (uint8_t col = 0; col < width; col++) {
+            uint8_t font_col = col / slot->scale;
+            bool on = font_col < FONT_GLYPH_COLUMNS && (columns[font_col] & bit);
+            uint16_t color = on ? slot->fg : slot->bg;
+            *out++ = color >> 8;
+            *out++ = color & 0xFF;
+        }
+    }
+}
+
+/* Cache slot for a character, expanding it into the least recently used slot on a miss */
+static glyph_slot_t* lookup_glyph(char c, uint16_t fg, uint16_t bg, uint8_t scale) {
+    if ((unsigned char)c < FONT_FIRST_CHAR || (unsigned char)c >= FONT_FIRST_CHAR + 96) {
+        c = '?';
+    }
+
+    glyph_slot_t* victim = &text_state.slots[0];
+    for (int i = 0; i < DISPLAY_TEXT_CACHE_GLYPHS; i++) {
+        glyph_slot_t* slot = &text_state.slots[i];
+        if (slot->last_used != 0 && slot->c == c && slot->fg == fg && slot->bg == bg &&
+            slot->scale == scale) {
+            slot->last_used = ++text_state.clock;
+            text_state.hits++;
+            return slot;
+        }
+        if (slot->last_used < victim->last_used) {
+            victim = slot;
+        }
+    }
+
+    /* The evicted glyph may still be queued for the display */
+    display_dma_wait(victim->fence);
+
+    victim->c = c;
+    victim->fg = fg;
+    victim->bg = bg;
+    victim->scale = scale;
+    victim->last_used = ++text_state.clock;
+    expand_glyph(victim);
+    text_state.misses++;
+    return victim;
+}
+
+/* Send `count` cells of one line, all on screen, starting at x */
+static void send_cells(const display_handle_t* display, int16_t x, int16_t y,
+                       const char* chars, size_t count, uint8_t scale) {
+    uint16_t cell_w = DISPLAY_TEXT_CELL_WIDTH * scale;
+    uint16_t cell_h = DISPLAY_TEXT_CELL_HEIGHT * scale;
+    uint32_t row_bytes = (uint32_t)cell_w * 2;
+    size_t per_window = DISPLAY_TEXT_LINE_BYTES / (row_bytes * cell_h);
+
+    while (count > 0) {
+        size_t n = count < per_window ? count : per_window;
+
+        if (n == 1) {
+            glyph_slot_t* slot = lookup_glyph(chars[0], display->text_color,
+                                              display->text_bg_color, scale);
+            slot->fence = display_dma_blit((uint16_t)x, (uint16_t)y, cell_w, cell_h, slot->pixels);
+        } else {
+            uint32_t line_stride = row_bytes * n;
+            display_dma_wait(text_state.line_fence);
+            for (size_t i = 0; i < n; i++) {
+                const uint8_t* glyph = lookup_glyph(chars[i], display->text_color,
+                                                    display->text_bg_color, scale)->pixels;
+                uint8_t* dst = text_state.line + i * row_bytes;
+                for (uint16_t row = 0; row < cell_h; row++) {
+                    memcpy(dst + row * line_stride, glyph + row * row_bytes, row_bytes);
+                }
+            }
+            text_state.line_fence = display_dma_blit((uint16_t)x, (uint16_t)y,
+                                                     (uint16_t)(cell_w * n), cell_h, text_state.line);
+        }
+
+        x += cell_w * n;
+        chars += n;
+        count -= n;
+    }
+}
+
+/* ===== API Implementation ===== */
+
+uint16_t display_draw_chars(display_handle_t* display, int16_t x, int16_t y,
+                            const char* chars, size_t count) {
+    if (!display || !chars || !display->initialized || count == 0 || !display_dma_is_ready()) {
+        return 0;
+    }
+
+    uint8_t scale = text_scale(display);
+    int32_t cell_w = DISPLAY_TEXT_CELL_WIDTH * scale;
+    int32_t cell_h = DISPLAY_TEXT_CELL_HEIGHT * scale;
+    uint16_t advance = (uint16_t)(cell_w * count);
+
+    if (y < 0 || y + cell_h > display->height) {
+        return advance;
+    }
+
+    /* Only cells entirely on screen are drawn */
+    size_t first = 0;
+    if (x < 0) {
+        first = (size_t)((-x + cell_w - 1) / cell_w);
+    }
+    int32_t fit = ((int32_t)display->width - x) / cell_w;
+    size_t end = fit < 0 ? 0 : (size_t)fit;
+    if (end > count) end = count;
+
+    if (first < end) {
+        send_cells(display, (int16_t)(x + first * cell_w), y, chars + first, end - first, scale);
+    }
+    return advance;
+}
+
+uint16_t display_draw_text(display_handle_t* display, int16_t x, int16_t y, const char* str) {
+    if (!str) {
+        return 0;
+    }
+    return display_draw_chars(display, x, y, str, strcspn(str, "\n"));
+}
+
+void display_text_init(display_handle_t* display, uint16_t width, uint16_t height) {
+    if (!display) {
+        return;
+    }
+    memset(display, 0, sizeof(*display));
+    display->width = width;
+    display->height = height;
+    display->text_color = COLOR_WHITE;
+    display->text_bg_color = COLOR_BLACK;
+    display->text_scale = 1;
+    display->text_wrap = true;
+    display->initialized = true;
+}
+
+void display_set_text_scale(display_handle_t* display, uint8_t scale) {
+    if (!display) {
+        return;
+    }
+    display->text_scale = scale < 1 ? 1 : (scale > DISPLAY_TEXT_MAX_SCALE ? DISPLAY_TEXT_MAX_SCALE : scale);
+}
+
+void display_text_field_init(display_text_field_t* field, int16_t x, int16_t y) {
+    if (!field) {
+        return;
+    }
+    memset(field, 0, sizeof(*field));
+    field->x = x;
+    field->y = y;
+}
+
+uint8_t display_text_field_update(display_handle_t* display, display_text_field_t* field,
+                                  const char* str) {
+    if (!display || !field || !str || !display->initialized) {
+        return 0;
+    }
+
+    uint8_t scale = text_scale(display);
+    uint16_t cell_w = DISPLAY_TEXT_CELL_WIDTH * scale;
+    size_t new_len = strlen(str);
+    if (new_len > DISPLAY_TEXT_FIELD_CHARS) new_len = DISPLAY_TEXT_FIELD_CHARS;
+
+    bool restyle = field->scale != scale || field->fg != display->text_color ||
+                   field->bg != display->text_bg_color;
+    if (restyle && field->scale != scale && field->length > 0) {
+        /* Old cells were a different size; clear them before redrawing */
+        display_dma_fill_rect((uint16_t)field->x, (uint16_t)field->y,
+                              field->length * DISPLAY_TEXT_CELL_WIDTH * field->scale,
+                              DISPLAY_TEXT_CELL_HEIGHT * field->scale, display->text_bg_color);
+        field->length = 0;
+    }
+
+    /* Cells past the new text are blanked with spaces */
+    size_t count = new_len > field->length ? new_len : field->length;
+    char shown[DISPLAY_TEXT_FIELD_CHARS];
+    for (size_t i = 0; i < count; i++) {
+        shown[i] = i < new_len ? str[i] : ' ';
+    }
+
+    uint8_t redrawn = 0;
+    size_t i = 0;
+    while (i < count) {
+        if (!restyle && i < field->length && field->text[i] == shown[i]) {
+            i++;
+            continue;
+        }
+        size_t start = i;
+        while (i < count && (restyle || i >= field->length || field->text[i] != shown[i])) {
+            i++;
+        }
+        display_draw_chars(display, (int16_t)(field->x + start * cell_w), field->y,
+                           shown + start, i - start);
+        redrawn += (uint8_t)(i - start);
+    }
+
+    memcpy(field->text, str, new_len);
+    field->text[new_len] = '\0';
+    field->length = (uint8_t)new_len;
+    field->scale = scale;
+    field->fg = display->text_color;
+    field->bg = display->text_bg_color;
+    return redrawn;
+}
+
+void display_text_cache_clear(void) {
+    for (int i = 0; i < DISPLAY_TEXT_CACHE_GLYPHS; i++) {
+        text_state.slots[i].last_used = 0;
+    }
+}
+
+void display_text_cache_stats(uint32_t* hits, uint32_t* misses) {
+    if (hits) *hits = text_state.hits;
+    if (misses) *misses = text_state.misses;
+}
@@ -0,0 +1,159 @@
+/**
+ * @file ili9341_text.h
+ * @brief Glyph-cached text rendering for the ILI9341 display driver
+ *
+ * Characters from the built-in 5x8 font are expanded once into RGB565
+ * pixels for the current text colors and scale and kept in a small LRU
+ * cache. A character is then a single address-window blit straight from
+ * the cache, and a run of characters on one line is assembled from cached
+ * glyph rows and sent as one window.
+ *
+ * Text fields remember what they last showed and redraw only the
+ * characters that changed, so a score counter or status line can be
+ * updated without clearing and repainting its surroundings.
+ *
+ * Each cell is 6x8 pixels (5x8 glyph plus one column of spacing) times the
+ * text scale; cell background is painted in the background color.
+ * Characters that do not fit on screen entirely are skipped.
+ *
+ * Pixels are queued on the display DMA engine (ili9341_dma.h), so
+ * display_dma_init() must have succeeded; until then nothing is drawn.
+ * Drawing returns before the panel is updated. Call display_dma_wait_idle()
+ * before touching the SPI bus by other means.
+ *
+ * The module needs only the DMA engine. A panel brought up elsewhere, e.g.
+ * with displaylib_16, can draw text through a handle from
+ * display_text_init().
+ */
+
+#ifndef ILI9341_TEXT_H
+#define ILI9341_TEXT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ili9341_display.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===== Configuration ===== */
+#ifndef DISPLAY_TEXT_CACHE_GLYPHS
+#define DISPLAY_TEXT_CACHE_GLYPHS 16  /* Expanded glyphs kept in RAM */
+#endif
+
+#ifndef DISPLAY_TEXT_MAX_SCALE
+#define DISPLAY_TEXT_MAX_SCALE 2      /* Largest text scale the cache holds */
+#endif
+
+#ifndef DISPLAY_TEXT_LINE_BYTES
+#define DISPLAY_TEXT_LINE_BYTES 4096  /* Staging for one multi-character window */
+#endif
+
+#ifndef DISPLAY_TEXT_FIELD_CHARS
+#define DISPLAY_TEXT_FIELD_CHARS 24   /* Longest text a field can show */
+#endif
+
+#define DISPLAY_TEXT_CELL_WIDTH  6
+#define DISPLAY_TEXT_CELL_HEIGHT 8
+
+/**
+ * @brief Fixed-position text that is updated in place
+ *
+ * Initialize with display_text_field_init(); the field then tracks the
+ * characters and colors currently on screen.
+ */
+typedef struct {
+    int16_t x;
+    int16_t y;
+    uint8_t length;                           /* Characters on screen */
+    uint8_t scale;                            /* Scale they were drawn at */
+    uint16_t fg;
+    uint16_t bg;
+    char text[DISPLAY_TEXT_FIELD_CHARS + 1];
+} display_text_field_t;
+
+/* ===== Public API ===== */
+
+/**
+ * @brief Draw characters on one line at a position, leaving the cursor alone
+ * @param display Pointer to display_handle_t
+ * @param x Left edge of the first cell
+ * @param y Top edge of the cells
+ * @param chars Characters to draw (no control characters)
+ * @param count Number of characters
+ * @return Width drawn in pixels, including skipped cells
+ */
+uint16_t display_draw_chars(display_handle_t* display, int16_t x, int16_t y,
+                            const char* chars, size_t count);
+
+/**
+ * @brief Draw one line of text at a position, leaving the cursor alone
+ * @param display Pointer to display_handle_t
+ * @param x Left edge of the first cell
+ * @param y Top edge of the cells
+ * @param str Null-terminated string; stops at the first newline
+ * @return Width drawn in pixels, including skipped cells
+ *
+ * Uses the display's text colors and scale. Consecutive characters go out
+ * as one window per DISPLAY_TEXT_LINE_BYTES of pixels.
+ */
+uint16_t display_draw_text(display_handle_t* display, int16_t x, int16_t y, const char* str);
+
+/**
+ * @brief Set up a handle for text on a panel initialized elsewhere
+ * @param display Handle to fill in
+ * @param width Panel width in pixels
+ * @param height Panel height in pixels
+ *
+ * Text starts out white on black at scale 1. Only the text functions in
+ * this header may be used with the handle.
+ */
+void display_text_init(display_handle_t* display, uint16_t width, uint16_t height);
+
+/**
+ * @brief Set the text scale used by the text functions
+ * @param display Pointer to display_handle_t
+ * @param scale 1 to DISPLAY_TEXT_MAX_SCALE (clamped)
+ */
+void display_set_text_scale(display_handle_t* display, uint8_t scale);
+
+/**
+ * @brief Set up an empty field at a position
+ * @param field Field to initialize
+ * @param x Left edge of the first cell
+ * @param y Top edge of the cells
+ */
+void display_text_field_init(display_text_field_t* field, int16_t x, int16_t y);
+
+/**
+ * @brief Show new text in a field, redrawing only what changed
+ * @param display Pointer to display_handle_t
+ * @param field Field from display_text_field_init()
+ * @param str New text, truncated to DISPLAY_TEXT_FIELD_CHARS
+ * @return Number of cells redrawn
+ *
+ * Each run of changed characters is one window. Cells left over from
+ * longer previous text are painted as spaces. A change of text colors or
+ * scale redraws the whole field.
+ */
+uint8_t display_text_field_update(display_handle_t* display, display_text_field_t* field,
+                                  const char* str);
+
+/**
+ * @brief Drop every cached glyph
+ */
+void display_text_cache_clear(void);
+
+/**
+ * @brief Get glyph cache lookup counts since startup
+ * @param hits Lookups served from the cache (may be NULL)
+ * @param misses Lookups that expanded a glyph (may be NULL)
+ */
+void display_text_cache_stats(uint32_t* hits, uint32_t* misses);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ILI9341_TEXT_H */
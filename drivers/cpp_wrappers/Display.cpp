@@ -63,6 +63,18 @@ void Display::writeString(const char* str) {
     display_write_string(&handle_, str);
 }
 
+uint16_t Display::drawText(int16_t x, int16_t y, const char* str) {
+    return display_draw_text(&handle_, x, y, str);
+}
+
+void Display::setTextScale(uint8_t scale) {
+    display_set_text_scale(&handle_, scale);
+}
+
+uint8_t Display::updateTextField(display_text_field_t& field, const char* str) {
+    return display_text_field_update(&handle_, &field, str);
+}
+
 void Display::setRotation(display_rotation_t rotation) {
     display_set_rotation(&handle_, rotation);
 }
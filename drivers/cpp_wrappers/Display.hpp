@@ -10,6 +10,7 @@
 #define DISPLAY_HPP
 
 #include "ili9341_display.h"
+#include "ili9341_text.h"
 #include <cstdint>
 #include <cstddef>
 
@@ -121,6 +122,29 @@ public:
      */
     void writeString(const char* str);
 
+    /**
+     * @brief Draw one line of text without moving the cursor
+     * @param x Left edge of the first character
+     * @param y Top edge of the line
+     * @param str Null-terminated string (stops at a newline)
+     * @return Width drawn in pixels
+     */
+    uint16_t drawText(int16_t x, int16_t y, const char* str);
+
+    /**
+     * @brief Set the text scale (1 to DISPLAY_TEXT_MAX_SCALE)
+     * @param scale Integer scale factor
+     */
+    void setTextScale(uint8_t scale);
+
+    /**
+     * @brief Update a fixed-position text field, redrawing changed characters only
+     * @param field Field set up with display_text_field_init()
+     * @param str New text
+     * @return Number of characters redrawn
+     */
+    uint8_t updateTextField(display_text_field_t& field, const char* str);
+
     /**
      * @brief Set display rotation
      * @param rotation 0, 90, 180, or 270 degrees
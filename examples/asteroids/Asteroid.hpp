@@ -18,22 +18,16 @@ public:
         // Update collider position handled by base GameObject
     }
 
-    void render(Display& display) override {
-        // Draw filled circle (simple pixel plot)
-        int16_t cx = (int16_t)position.x + (int16_t)radius;
-        int16_t cy = (int16_t)position.y + (int16_t)radius;
+    void render(Renderer& renderer) override {
+        // Filled circle, one fill per row span
         int16_t r = (int16_t)radius;
-        for (int16_t y = -r; y <= r; y++) {
-            for (int16_t x = -r; x <= r; x++) {
-                if (x*x + y*y <= r*r) {
-                    int16_t px = cx + x;
-                    int16_t py = cy + y;
-                    if (px >= 0 && py >= 0 && px < display.getWidth() && py < display.getHeight()) {
-                        display.drawPixel((uint16_t)px, (uint16_t)py, color);
-                    }
-                }
-            }
-        }
+        renderer.fillCircle((int16_t)position.x + r, (int16_t)position.y + r, r, color);
+    }
+
+    // The circle spans 2r + 1 pixels, one more than the collider
+    Rect getRenderBounds() const override {
+        int16_t r = (int16_t)radius;
+        return Rect::fromSize((int16_t)position.x, (int16_t)position.y, 2 * r + 1, 2 * r + 1);
     }
     Type getType() const override { return Type::Asteroid; }
 };
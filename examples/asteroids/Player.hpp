@@ -23,22 +23,14 @@ public:
         GameObject::update(deltaTime);
     }
 
-    void render(Display& display) override {
-        // Render player as filled circle
-        int16_t cx = (int16_t)position.x + 8;
-        int16_t cy = (int16_t)position.y + 8;
-        int16_t r = 8;
-        for (int16_t y = -r; y <= r; y++) {
-            for (int16_t x = -r; x <= r; x++) {
-                if (x*x + y*y <= r*r) {
-                    int16_t px = cx + x;
-                    int16_t py = cy + y;
-                    if (px >= 0 && py >= 0 && px < display.getWidth() && py < display.getHeight()) {
-                        display.drawPixel((uint16_t)px, (uint16_t)py, color);
-                    }
-                }
-            }
-        }
+    void render(Renderer& renderer) override {
+        // Render player as filled circle, one fill per row span
+        renderer.fillCircle((int16_t)position.x + 8, (int16_t)position.y + 8, 8, color);
+    }
+
+    // The circle spans 17 pixels, one more than the collider
+    Rect getRenderBounds() const override {
+        return Rect::fromSize((int16_t)position.x, (int16_t)position.y, 17, 17);
     }
     Type getType() const override { return Type::Player; }
 };
@@ -0,0 +1,110 @@
+#include <stdio.h>
+#include <vector>
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "GameObject.hpp"
+#include "EntityWorld.hpp"
+#include "SpatialHash.hpp"
+
+// Runs the same 500-body scene as GameObjects and as EntityWorld entities,
+// timing the per-frame logic the engine does for each layout: integrate,
+// build the collision grid, then narrowphase the candidate pairs. Rendering
+// is identical for both layouts and is left out.
+
+#define ENTITY_COUNT 500
+#define FRAMES 50
+
+class BenchBox : public GameObject {
+public:
+    BenchBox(const Vector2& pos, const Vector2& vel)
+        : GameObject(pos, BoxCollider(6, 6)) {
+        velocity = vel;
+    }
+
+    void render(Renderer& renderer) override {}
+};
+
+static Vector2 startPosition(int i) {
+    return Vector2((i * 37) % 234, (i * 53) % 314);
+}
+
+static Vector2 startVelocity(int i) {
+    return Vector2((i % 7) - 3, (i % 5) - 2);
+}
+
+static void report(const char* name, uint64_t elapsed, uint32_t hits) {
+    uint32_t cyclesPerUs = clock_get_hz(clk_sys) / 1000000;
+    printf("%-12s %6lu us/frame  %8lu cycles/frame  (%lu hits)\n", name,
+           (unsigned long)(elapsed / FRAMES),
+           (unsigned long)(elapsed * cyclesPerUs / FRAMES), (unsigned long)hits);
+}
+
+static void benchObjects(SpatialHash& grid) {
+    std::vector<GameObjectPtr> objects;
+    objects.reserve(ENTITY_COUNT);
+    for (int i = 0; i < ENTITY_COUNT; i++) {
+        objects.push_back(GameObjectPtr(new BenchBox(startPosition(i), startVelocity(i))));
+    }
+
+    uint32_t hits = 0;
+    uint64_t start = time_us_64();
+    for (int frame = 0; frame < FRAMES; frame++) {
+        for (auto& obj : objects) {
+            obj->update(0.016f);
+        }
+
+        grid.clear();
+        for (size_t i = 0; i < objects.size(); i++) {
+            grid.insert(i, objects[i]->getScreenBounds());
+        }
+        grid.build();
+        grid.forEachPair([&](uint16_t a, uint16_t b) {
+            if (objects[a]->collidesWith(*objects[b])) hits++;
+        });
+    }
+    report("GameObject", time_us_64() - start, hits);
+}
+
+static void benchEntities(SpatialHash& grid) {
+    static EntityWorld world(ENTITY_COUNT);
+    world.destroyAll();
+    DirtyRegion unused;
+    world.removeInactive(unused);
+
+    for (int i = 0; i < ENTITY_COUNT; i++) {
+        uint32_t id = world.create(startPosition(i), 6, 6);
+        world.setVelocity(id, startVelocity(i));
+    }
+
+    uint32_t hits = 0;
+    uint64_t start = time_us_64();
+    for (int frame = 0; frame < FRAMES; frame++) {
+        world.integrate(Scalar(0.016f));
+
+        grid.clear();
+        world.insertColliders(grid, 0);
+        grid.build();
+        grid.forEachPair([&](uint16_t a, uint16_t b) {
+            if (world.overlaps(a, b)) hits++;
+        });
+    }
+    report("EntityWorld", time_us_64() - start, hits);
+}
+
+int main() {
+    stdio_init_all();
+
+    sleep_ms(2000);
+
+    printf("ECS benchmark: %d bodies, %d frames\n", ENTITY_COUNT, FRAMES);
+
+    SpatialHash grid(240, 320);
+    while (true) {
+        benchObjects(grid);
+        benchEntities(grid);
+        printf("\n");
+        sleep_ms(2000);
+    }
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "Vector.hpp"
+#include "BoxCollider.hpp"
+
+// Compares one update + collision pass with soft-float and Q16.16 fixed
+// point, independent of the PICO_GAME_FIXED_POINT setting: every object is
+// integrated, steered with normalized(), then all pairs are box-tested.
+
+#define OBJECT_COUNT 60
+#define PASSES 100
+
+template <typename T>
+struct BenchObject {
+    Vector2T<T> position;
+    Vector2T<T> velocity;
+    BoxColliderT<T> collider;
+};
+
+template <typename T>
+static void setup(BenchObject<T>* objects) {
+    for (int i = 0; i < OBJECT_COUNT; i++) {
+        objects[i].position = Vector2T<T>(T((i * 37) % 224), T((i * 53) % 304));
+        objects[i].velocity = Vector2T<T>(T((i % 7) - 3), T((i % 5) - 2));
+        objects[i].collider = BoxColliderT<T>(T(16), T(16));
+    }
+}
+
+// Returns the hit count so the work can't be optimized away
+template <typename T>
+static uint32_t runPass(BenchObject<T>* objects, T deltaTime, const Vector2T<T>& target) {
+    for (int i = 0; i < OBJECT_COUNT; i++) {
+        BenchObject<T>& obj = objects[i];
+        Vector2T<T> steer = (target - obj.position).normalized();
+        obj.velocity = obj.velocity + steer * deltaTime;
+        obj.position = obj.position + obj.velocity * deltaTime;
+    }
+
+    uint32_t hits = 0;
+    for (int i = 0; i < OBJECT_COUNT; i++) {
+        for (int j = i + 1; j < OBJECT_COUNT; j++) {
+            if (objects[i].collider.intersects(objects[i].position,
+                                               objects[j].collider, objects[j].position)) {
+                hits++;
+            }
+        }
+    }
+    return hits;
+}
+
+template <typename T>
+static void bench(const char* name) {
+    static BenchObject<T> objects[OBJECT_COUNT];
+    setup(objects);
+
+    T deltaTime = T(0.016f);
+    Vector2T<T> target(T(120), T(160));
+    uint32_t hits = 0;
+
+    uint64_t start = time_us_64();
+    for (int pass = 0; pass < PASSES; pass++) {
+        hits += runPass(objects, deltaTime, target);
+    }
+    uint64_t elapsed = time_us_64() - start;
+
+    uint32_t cyclesPerUs = clock_get_hz(clk_sys) / 1000000;
+    uint32_t cyclesPerPass = (uint32_t)(elapsed * cyclesPerUs / PASSES);
+    printf("%-12s %6lu us/pass  %8lu cycles/pass  (%lu hits)\n", name,
+           (unsigned long)(elapsed / PASSES), (unsigned long)cyclesPerPass, (unsigned long)hits);
+}
+
+int main() {
+    stdio_init_all();
+
+    sleep_ms(2000);
+
+    printf("Fixed-point benchmark: %d objects, %d pair tests per pass\n",
+           OBJECT_COUNT, OBJECT_COUNT * (OBJECT_COUNT - 1) / 2);
+
+    while (true) {
+        bench<float>("soft-float");
+        bench<Fixed>("Q16.16");
+        printf("\n");
+        sleep_ms(2000);
+    }
+
+    return 0;
+}
@@ -85,22 +85,18 @@ int main() {
     uint8_t tx_frame[kMaxPayload] = {0};
     size_t tx_frame_len = 0;
 
-    uint8_t rx_buffer[kMaxPayload];
-    RadioStream::RxBuffer rx{rx_buffer, sizeof(rx_buffer), 0};
+    // Frames arrive split across kChunkSize packets, so each acquired chunk is
+    // copied out before release() and the frame is decrypted once reassembled
     uint8_t rx_frame[kMaxPayload] = {0};
     size_t rx_len = 0;
     size_t rx_expected = 0;
 
-    bool rx_active = true;
-    radio.start_rx();
-
     while (true) {
         radio.poll();
 
-        if (radio.available()) {
-            radio >> rx;
-            for (size_t i = 0; i < rx.length; ++i) {
-                uint8_t byte = rx_buffer[i];
+        while (const RadioStream::RxPacket* packet = radio.acquire()) {
+            for (size_t i = 0; i < packet->length; ++i) {
+                uint8_t byte = packet->data[i];
                 if (rx_len < kMaxPayload) {
                     rx_frame[rx_len++] = byte;
                 }
@@ -115,13 +111,10 @@ int main() {
                 }
                 if (rx_expected > 0 && rx_len >= rx_expected) {
                     size_t cipher_len = rx_expected - kLenSize - kIvSize;
-                    uint8_t iv[kIvSize];
-                    memcpy(iv, &rx_frame[kLenSize], kIvSize);
-                    uint8_t plain[kMaxCipher];
-                    memcpy(plain, &rx_frame[kLenSize + kIvSize], cipher_len);
+                    uint8_t* plain = &rx_frame[kLenSize + kIvSize];
 
                     AES_ctx ctx;
-                    AES_init_ctx_iv(&ctx, kAesKey, iv);
+                    AES_init_ctx_iv(&ctx, kAesKey, &rx_frame[kLenSize]);
                     AES_CBC_decrypt_buffer(&ctx, plain, static_cast<uint32_t>(cipher_len));
 
                     size_t plain_len = pkcs7_unpad(plain, cipher_len);
@@ -134,7 +127,7 @@ int main() {
                     rx_expected = 0;
                 }
             }
-            rx_active = false;
+            radio.release();
         }
 
         if (!tx_pending && tx_plain_len < kMaxPlaintext) {
@@ -180,14 +173,17 @@ int main() {
             }
         }
 
-        if (tx_pending && !radio.tx_busy()) {
+        // Queue as many chunks as fit; they go out back to back and the
+        // radio returns to RX after the last one
+        while (tx_pending) {
             for (size_t i = 0; i < kChunkSize; ++i) {
                 size_t idx = tx_offset + i;
                 tx_chunk[i] = (idx < tx_frame_len) ? tx_frame[idx] : 0;
             }
-            radio.send(tx_chunk, kChunkSize);
+            if (!radio.send(tx_chunk, kChunkSize)) {
+                break;
+            }
             tx_offset += kChunkSize;
-            rx_active = false;
 
             if (tx_offset >= tx_total_padded) {
                 tx_pending = false;
@@ -195,11 +191,6 @@ int main() {
             }
         }
 
-        if (!radio.tx_busy() && !radio.available() && !rx_active) {
-            radio.start_rx();
-            rx_active = true;
-        }
-
         tight_loop_contents();
     }
 
@@ -5,6 +5,8 @@
 #include "pico/stdlib.h"
 #include "pico/radio_stream.hpp"
 #include "displaylib_16/ili9341.hpp"
+#include "ili9341_dma.h"
+#include "ili9341_text.h"
 
 extern "C" {
 #include "aes.h"
@@ -16,6 +18,12 @@ constexpr size_t kLenSize = 2;
 constexpr size_t kMaxPayload = 255;
 constexpr size_t kMaxCipher = 224; // Multiple of 16, fits in payload with header+IV.
 constexpr size_t kMaxPlaintext = kMaxCipher - 1;
+constexpr int8_t kPinDc = 21;
+constexpr int8_t kPinCs = 17;
+constexpr uint16_t kWidth = 240;
+constexpr uint16_t kHeight = 320;
+constexpr int16_t kMessageTop = 16; // Below the status line
+constexpr uint16_t kMessageColumns = kWidth / DISPLAY_TEXT_CELL_WIDTH;
 
 static const uint8_t kAesKey[32] = {
     0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef,
@@ -40,17 +48,47 @@ size_t pkcs7_unpad(uint8_t* buffer, size_t length) {
     return length - pad_len;
 }
 
-void init_display(ILI9341_TFT& display) {
-    display.SetupGPIO(20, 21, 17, 18, 19, 16);
-    display.SetupScreenSize(240, 320);
+// displaylib brings the panel up and clears it once; text then goes out
+// through the glyph cache on the DMA queue
+void init_display(ILI9341_TFT& display, display_handle_t& text, display_text_field_t& status) {
+    display.SetupGPIO(20, kPinDc, kPinCs, 18, 19, 16);
+    display.SetupScreenSize(kWidth, kHeight);
     display.SetupSPI(25000000, spi0);
     display.ILI9341Initialize();
-
     display.fillScreen(display.C_BLACK);
-    display.setTextColor(display.C_WHITE, display.C_BLACK);
-    display.setTextWrap(true);
-    display.setCursor(0, 0);
-    display.println("Waiting for LoRa...");
+
+    display_dma_init(spi0, kPinDc, kPinCs);
+    display_text_init(&text, kWidth, kHeight);
+
+    // The status line is a text field, so updates redraw only changed characters
+    display_text_field_init(&status, 0, 0);
+    display_text_field_update(&text, &status, "Waiting for LoRa...");
+}
+
+// Replace the previous message, clearing only the lines it used. Returns
+// the number of lines drawn.
+uint16_t show_message(display_handle_t& text, const char* message, size_t length,
+                      uint16_t previous_lines) {
+    if (previous_lines > 0) {
+        display_dma_fill_rect(0, kMessageTop, kWidth, previous_lines * DISPLAY_TEXT_CELL_HEIGHT,
+                              text.text_bg_color);
+    }
+
+    uint16_t lines = 0;
+    int16_t y = kMessageTop;
+    const char* end = message + length;
+    while (message < end && y + DISPLAY_TEXT_CELL_HEIGHT <= kHeight) {
+        const char* newline = static_cast<const char*>(memchr(message, '\n', end - message));
+        size_t run = (newline ? newline : end) - message;
+        if (run > kMessageColumns) run = kMessageColumns;
+        display_draw_chars(&text, 0, y, message, run);
+
+        message += run;
+        if (message < end && *message == '\n') message++;
+        y += DISPLAY_TEXT_CELL_HEIGHT;
+        lines++;
+    }
+    return lines;
 }
 } // namespace
 
@@ -62,45 +100,45 @@ int main() {
     radio.init(config);
 
     ILI9341_TFT display;
-    init_display(display);
+    display_handle_t text;
+    display_text_field_t status;
+    init_display(display, text, status);
 
-    uint8_t rx_buffer[kMaxPayload] = {0};
-    RadioStream::RxBuffer rx{rx_buffer, sizeof(rx_buffer), 0};
+    uint32_t message_count = 0;
+    uint16_t message_lines = 0;
 
     while (true) {
         radio.poll();
 
-        if (radio.available()) {
-            radio >> rx;
-            if (rx.length >= kLenSize + kIvSize) {
-                size_t cipher_len = (static_cast<size_t>(rx_buffer[0]) << 8) | rx_buffer[1];
+        // Borrow each packet and decrypt it in place in the receive queue
+        while (RadioStream::RxPacket* packet = radio.acquire()) {
+            uint8_t* frame = packet->data;
+            if (packet->length >= kLenSize + kIvSize) {
+                size_t cipher_len = (static_cast<size_t>(frame[0]) << 8) | frame[1];
                 size_t expected = kLenSize + kIvSize + cipher_len;
                 if (cipher_len > 0 && cipher_len <= kMaxCipher && (cipher_len % 16) == 0 &&
-                    rx.length >= expected) {
-                    uint8_t iv[kIvSize];
-                    memcpy(iv, &rx_buffer[kLenSize], kIvSize);
-
-                    uint8_t plain[kMaxCipher];
-                    memcpy(plain, &rx_buffer[kLenSize + kIvSize], cipher_len);
+                    packet->length >= expected) {
+                    uint8_t* plain = &frame[kLenSize + kIvSize];
 
                     AES_ctx ctx;
-                    AES_init_ctx_iv(&ctx, kAesKey, iv);
+                    AES_init_ctx_iv(&ctx, kAesKey, &frame[kLenSize]);
                     AES_CBC_decrypt_buffer(&ctx, plain, static_cast<uint32_t>(cipher_len));
 
                     size_t plain_len = pkcs7_unpad(plain, cipher_len);
                     if (plain_len > 0) {
-                        size_t copy_len = (plain_len < kMaxPlaintext) ? plain_len : kMaxPlaintext;
-                        char text[kMaxPlaintext + 1];
-                        memcpy(text, plain, copy_len);
-                        text[copy_len] = '\0';
-
-                        display.fillScreen(display.C_BLACK);
-                        display.setCursor(0, 0);
-                        display.print(text);
+                        // Drawn straight from the packet; the characters are
+                        // consumed before show_message() returns
+                        char status_text[DISPLAY_TEXT_FIELD_CHARS + 1];
+                        snprintf(status_text, sizeof(status_text), "Messages: %lu",
+                                 static_cast<unsigned long>(++message_count));
+                        display_text_field_update(&text, &status, status_text);
+                        message_lines = show_message(text, reinterpret_cast<const char*>(plain),
+                                                     plain_len < kMaxPlaintext ? plain_len : kMaxPlaintext,
+                                                     message_lines);
                     }
                 }
             }
-            radio.start_rx();
+            radio.release();
         }
 
         sleep_ms(5);
@@ -59,14 +59,17 @@ int main() {
     while (true) {
         radio.poll();
 
+        // At SF12 a frame is about 2 s on air, longer than the send interval,
+        // so wait for a free queue slot rather than drop frames
         uint32_t now_ms = to_ms_since_boot(get_absolute_time());
-        if (!radio.tx_busy() && static_cast<int32_t>(now_ms - next_send_ms) >= 0) {
+        if (static_cast<int32_t>(now_ms - next_send_ms) >= 0 &&
+            radio.tx_pending() < RadioStream::kTxQueueDepth) {
             char message[kMaxPlaintext + 1] = {0};
             int msg_len = snprintf(message, sizeof(message), "message%llu\n",
-                                   static_cast<unsigned long long>(message_counter++));
+                                   static_cast<unsigned long long>(message_counter));
             if (msg_len > 0 && static_cast<size_t>(msg_len) < sizeof(message)) {
                 uint8_t iv[kIvSize];
-                build_iv(iv, iv_counter++);
+                build_iv(iv, iv_counter);
 
                 uint8_t cipher[kMaxCipher];
                 memcpy(cipher, message, static_cast<size_t>(msg_len));
@@ -82,10 +85,14 @@ int main() {
                     memcpy(&tx_frame[kLenSize + kIvSize], cipher, padded_len);
                     size_t frame_len = kLenSize + kIvSize + padded_len;
 
-                    radio.send(tx_frame, frame_len);
+                    // The counters only move on once the frame is queued
+                    if (radio.send(tx_frame, frame_len)) {
+                        message_counter++;
+                        iv_counter++;
+                        next_send_ms = now_ms + kSendIntervalMs;
+                    }
                 }
             }
-            next_send_ms = now_ms + kSendIntervalMs;
         }
 
         sleep_ms(5);
@@ -3,6 +3,7 @@
 
 #include "pico/stdlib.h"
 #include "pico/radio_stream.hpp"
+#include "pico/sx126x-busy.h"
 
 int main()
 {
@@ -17,6 +18,7 @@ int main()
 
     uint8_t buffer[255];
     RadioStream::RxBuffer rx{buffer, sizeof(buffer), 0};
+    uint32_t next_stats_ms = to_ms_since_boot(get_absolute_time()) + 10000;
 
     while (true)
     {
@@ -25,13 +27,30 @@ int main()
         if (radio.available())
         {
             radio >> rx;
-            printf("RX %u bytes RSSI %d SNR %d: ", static_cast<unsigned>(rx.length), radio.last_rssi(), radio.last_snr());
+            printf("RX %u bytes RSSI %d SNR %d at %llu us (%u dropped): ",
+                   static_cast<unsigned>(rx.length), rx.rssi, rx.snr,
+                   static_cast<unsigned long long>(rx.timestamp_us),
+                   static_cast<unsigned>(radio.rx_overflows()));
             for (size_t i = 0; i < rx.length; ++i)
             {
                 printf("%02x", buffer[i]);
             }
             printf("\n");
-            radio.start_rx();
+        }
+
+        // Longest radio BUSY stalls per command, every 10 s
+        uint32_t now_ms = to_ms_since_boot(get_absolute_time());
+        if (static_cast<int32_t>(now_ms - next_stats_ms) >= 0)
+        {
+            SX126xBusyStats_t stats[SX126X_BUSY_STATS_COMMANDS];
+            uint8_t count = SX126xGetBusyStats(stats, SX126X_BUSY_STATS_COMMANDS);
+            for (uint8_t i = 0; i < count; ++i)
+            {
+                printf("BUSY 0x%02x: %lu waits, max %lu us\n", stats[i].Command,
+                       static_cast<unsigned long>(stats[i].Waits),
+                       static_cast<unsigned long>(stats[i].MaxUs));
+            }
+            next_stats_ms = now_ms + 10000;
         }
 
         sleep_ms(5);
@@ -5,6 +5,14 @@
 #include "pico/stdlib.h"
 #include "pico/radio_stream.hpp"
 
+static void on_sent(RadioStream::TxStatus status, void*)
+{
+    if (status == RadioStream::TxStatus::Timeout)
+    {
+        printf("TX timeout\n");
+    }
+}
+
 int main()
 {
     stdio_init_all();
@@ -17,25 +25,15 @@ int main()
     radio.init(config);
 
     const uint8_t payload[] = {'H', 'E', 'L', 'L', 'O'};
-    RadioStream::TxBuffer tx{payload, sizeof(payload)};
     absolute_time_t next_tx = make_timeout_time_ms(1000);
 
     while (true)
     {
         radio.poll();
 
-        if (!radio.tx_busy() && time_reached(next_tx))
-        {
-            radio << tx;
-            if (radio.tx_busy())
-            {
-                next_tx = make_timeout_time_ms(1000);
-            }
-        }
-
-        if (radio.last_tx_timeout())
+        if (time_reached(next_tx) && radio.send(payload, sizeof(payload), on_sent, nullptr))
         {
-            printf("TX timeout\n");
+            next_tx = make_timeout_time_ms(1000);
         }
 
         sleep_ms(5);
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+
+// Compact sprite formats for Renderer::blitIndexed(), blitRle() and
+// blitMasked(),
+// generated from PNGs by tools/png2sprite.py. The descriptor and its
+// arrays are normally const (flash); with dual core they are read after
+// the call returns, so they must outlive the frame like any blit data.
+
+// 4- or 8-bit palette indices, row-major. 4-bit rows start on a byte
+// boundary with the left pixel in the high nibble. Palette entries are
+// RGB565 in wire byte order (high byte first in memory, i.e. byte-swapped
+// on the RP2040), so they expand straight into SPI staging and strip
+// buffers.
+struct IndexedBitmap {
+    const uint8_t* indices;
+    const uint16_t* palette;
+    uint16_t width;
+    uint16_t height;
+    uint8_t bits;              // 4 or 8
+    int16_t transparentIndex;  // Skipped when drawing; -1 if fully opaque
+
+    uint32_t rowBytes() const { return bits == 4 ? (width + 1) / 2 : width; }
+
+    uint8_t indexAt(const uint8_t* row, uint16_t x) const {
+        if (bits == 8) return row[x];
+        uint8_t pair = row[x >> 1];
+        return (x & 1) ? pair & 0x0F : pair >> 4;
+    }
+};
+
+// Run-length encoded rows of big-endian RGB565. Each row is a sequence of
+// runs covering exactly `width` pixels: a control byte c below 0x80 skips
+// c + 1 transparent pixels; c >= 0x80 is followed by (c & 0x7F) + 1 opaque
+// pixels, which go out as one window straight from the data.
+struct RleBitmap {
+    static constexpr uint8_t OPAQUE = 0x80;
+    static constexpr uint8_t MAX_RUN = 0x80;
+
+    const uint8_t* data;
+    const uint32_t* rowOffsets;  // Offset of each row's first run in data
+    uint16_t width;
+    uint16_t height;
+};
+
+// Big-endian RGB565 bytes (the wire order, as in assets.hpp) with a
+// precomputed 1-bit opacity mask instead of a color key. Mask rows start on
+// a byte boundary, leftmost pixel in the high bit, 1 = opaque. Runs are
+// found from the mask a byte at a time and sent straight from the data, so
+// no pixel is read or compared on the CPU.
+struct MaskedBitmap {
+    const uint8_t* data;
+    const uint8_t* mask;
+    uint16_t width;
+    uint16_t height;
+
+    uint32_t maskRowBytes() const { return (width + 7) / 8; }
+};
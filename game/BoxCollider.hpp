@@ -2,20 +2,26 @@
 
 #include "Vector.hpp"
 
-class BoxCollider {
+// Axis-aligned box collider over float or Fixed; the engine uses
+// BoxCollider (BoxColliderT<Scalar>)
+template <typename T>
+class BoxColliderT {
+public:
+    using Vector2 = Vector2T<T>;
+
 private:
-    float width, height;
+    T width, height;
     Vector2 offset;
 
 public:
-    BoxCollider(float w = 0.0f, float h = 0.0f, const Vector2& off = Vector2(0.0f, 0.0f))
+    BoxColliderT(T w = T(0), T h = T(0), const Vector2& off = Vector2(T(0), T(0)))
         : width(w), height(h), offset(off) {}
 
     // Get width and height
-    float getWidth() const { return width; }
-    float getHeight() const { return height; }
-    void setWidth(float w) { width = w; }
-    void setHeight(float h) { height = h; }
+    T getWidth() const { return width; }
+    T getHeight() const { return height; }
+    void setWidth(T w) { width = w; }
+    void setHeight(T h) { height = h; }
 
     // Get and set offset
     Vector2 getOffset() const { return offset; }
@@ -24,8 +30,8 @@ public:
     // Get the center point of the collider in world space
     Vector2 getCenter(const Vector2& objectPos) const {
         return Vector2(
-            objectPos.x + offset.x + width / 2.0f,
-            objectPos.y + offset.y + height / 2.0f
+            objectPos.x + offset.x + width * T(0.5f),
+            objectPos.y + offset.y + height * T(0.5f)
         );
     }
 
@@ -36,7 +42,7 @@ public:
     }
 
     // Check if two axis-aligned bounding boxes intersect
-    bool intersects(const Vector2& pos1, const BoxCollider& other, const Vector2& pos2) const {
+    bool intersects(const Vector2& pos1, const BoxColliderT& other, const Vector2& pos2) const {
         Vector2 min1, max1, min2, max2;
         getBounds(pos1, min1, max1);
         other.getBounds(pos2, min2, max2);
@@ -56,26 +62,28 @@ public:
     }
 
     // Get the overlap amount between two colliders (useful for collision response)
-    Vector2 getOverlap(const Vector2& pos1, const BoxCollider& other, const Vector2& pos2) const {
+    Vector2 getOverlap(const Vector2& pos1, const BoxColliderT& other, const Vector2& pos2) const {
         Vector2 min1, max1, min2, max2;
         getBounds(pos1, min1, max1);
         other.getBounds(pos2, min2, max2);
 
-        float overlapX = 0.0f;
-        float overlapY = 0.0f;
+        T overlapX = T(0);
+        T overlapY = T(0);
 
         if (min1.x < max2.x && max1.x > min2.x) {
-            float leftOverlap = max2.x - min1.x;
-            float rightOverlap = max1.x - min2.x;
+            T leftOverlap = max2.x - min1.x;
+            T rightOverlap = max1.x - min2.x;
             overlapX = (leftOverlap < rightOverlap) ? -leftOverlap : rightOverlap;
         }
 
         if (min1.y < max2.y && max1.y > min2.y) {
-            float topOverlap = max2.y - min1.y;
-            float bottomOverlap = max1.y - min2.y;
+            T topOverlap = max2.y - min1.y;
+            T bottomOverlap = max1.y - min2.y;
             overlapY = (topOverlap < bottomOverlap) ? -topOverlap : bottomOverlap;
         }
 
         return Vector2(overlapX, overlapY);
     }
 };
+
+using BoxCollider = BoxColliderT<Scalar>;
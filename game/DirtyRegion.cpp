@@ -0,0 +1,87 @@
+#include "DirtyRegion.hpp"
+
+DirtyRegion::DirtyRegion(const Rect& bounds)
+    : count_(0), bounds_(bounds), grid_(1) {}
+
+int16_t DirtyRegion::gridFloor(int16_t v) const {
+    int16_t rem = v % grid_;
+    return rem < 0 ? v - rem - grid_ : v - rem;
+}
+
+int16_t DirtyRegion::gridCeil(int16_t v) const {
+    int16_t floor = gridFloor(v);
+    return floor == v ? v : floor + grid_;
+}
+
+void DirtyRegion::add(const Rect& rect) {
+    if (rect.isEmpty()) return;
+
+    Rect r = rect;
+    if (grid_ > 1) {
+        r = Rect(gridFloor(r.x0), gridFloor(r.y0), gridCeil(r.x1), gridCeil(r.y1));
+    }
+    r = r.clipped(bounds_);
+    if (r.isEmpty()) return;
+
+    // Absorb every rectangle the new one overlaps; the union can reach
+    // rectangles the original did not, so rescan after each merge
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (size_t i = 0; i < count_; i++) {
+            if (rects_[i].contains(r)) return;
+            if (rects_[i].intersects(r)) {
+                r = r.united(rects_[i]);
+                removeAt(i);
+                merged = true;
+                break;
+            }
+        }
+    }
+
+    if (count_ < MAX_RECTS) {
+        rects_[count_++] = r;
+        return;
+    }
+
+    // Full: grow whichever entry needs the least extra area to cover r
+    size_t best = 0;
+    int32_t bestGrowth = INT32_MAX;
+    for (size_t i = 0; i < count_; i++) {
+        int32_t growth = rects_[i].united(r).area() - rects_[i].area();
+        if (growth < bestGrowth) {
+            bestGrowth = growth;
+            best = i;
+        }
+    }
+
+    Rect grown = rects_[best].united(r);
+    removeAt(best);
+    add(grown);
+}
+
+bool DirtyRegion::intersects(const Rect& rect) const {
+    for (size_t i = 0; i < count_; i++) {
+        if (rects_[i].intersects(rect)) return true;
+    }
+    return false;
+}
+
+bool DirtyRegion::contains(const Rect& rect) const {
+    for (size_t i = 0; i < count_; i++) {
+        if (rects_[i].contains(rect)) return true;
+    }
+    return false;
+}
+
+int32_t DirtyRegion::area() const {
+    int32_t total = 0;
+    for (size_t i = 0; i < count_; i++) {
+        total += rects_[i].area();
+    }
+    return total;
+}
+
+void DirtyRegion::removeAt(size_t index) {
+    rects_[index] = rects_[--count_];
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "Rect.hpp"
+
+// Fixed-capacity set of screen rectangles that need repainting this frame.
+// Overlapping rectangles are merged on insertion so each pixel is cleared
+// at most once; when the set is full the new rectangle is folded into the
+// entry whose bounding box grows the least.
+class DirtyRegion {
+public:
+    static constexpr size_t MAX_RECTS = 24;
+
+    DirtyRegion(const Rect& bounds = Rect());
+
+    // Limit all rectangles to this area (normally the screen)
+    void setBounds(const Rect& bounds) { bounds_ = bounds; }
+    const Rect& getBounds() const { return bounds_; }
+
+    // Grow added rectangles outward to multiples of `size` (1 = off), so
+    // they line up with a tile grid
+    void setGrid(int16_t size) { grid_ = size > 1 ? size : 1; }
+
+    // Mark a rectangle dirty (clipped to bounds, empty rects are ignored)
+    void add(const Rect& rect);
+
+    // Mark the whole bounds dirty
+    void addAll() { add(bounds_); }
+
+    void clear() { count_ = 0; }
+
+    bool isEmpty() const { return count_ == 0; }
+    size_t count() const { return count_; }
+    const Rect& operator[](size_t index) const { return rects_[index]; }
+
+    // True if rect touches any dirty rectangle
+    bool intersects(const Rect& rect) const;
+
+    // True if rect lies entirely inside a single dirty rectangle
+    bool contains(const Rect& rect) const;
+
+    // Total dirty area in pixels
+    int32_t area() const;
+
+private:
+    Rect rects_[MAX_RECTS];
+    size_t count_;
+    Rect bounds_;
+    int16_t grid_;
+
+    void removeAt(size_t index);
+
+    // Round down / up to a multiple of grid_
+    int16_t gridFloor(int16_t v) const;
+    int16_t gridCeil(int16_t v) const;
+};
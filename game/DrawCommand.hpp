@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include "SpscRing.hpp"
+#include "pico/stdlib.h"
+
+// One recorded Renderer call, replayed on the render core
+struct DrawCommand {
+    enum class Op : uint8_t {
+        FillRect,
+        Pixel,
+        Line,
+        Circle,          // Radius in w
+        FillCircle,      // Radius in w
+        Blit,
+        BlitTransparent,
+        Blit16,
+        Blit16Transparent,
+        BlitIndexed,     // data is the IndexedBitmap
+        BlitRle,         // data is the RleBitmap
+        BlitMasked,      // data is the MaskedBitmap
+        Origin,          // Renderer::setView offset (x, y)
+        Clip,            // Renderer::setView area
+        EndFrame
+    };
+
+    Op op;
+    uint16_t color;      // Fill/line color, or transparent color for blits
+    int16_t x, y;
+    int16_t w, h;        // Size, or end point for lines
+    const void* data;    // Bitmap source for blits
+};
+
+// Command stream from the game core to the render core. The producer blocks
+// while the ring is full and keeps track of how long it waited.
+class DrawCommandQueue {
+public:
+    static constexpr size_t CAPACITY = 1024;
+
+    void push(const DrawCommand& cmd) {
+        if (ring_.tryPush(cmd)) return;
+
+        uint32_t start = time_us_32();
+        while (!ring_.tryPush(cmd)) {
+            tight_loop_contents();
+        }
+        stallUs_ += time_us_32() - start;
+    }
+
+    bool tryPop(DrawCommand& cmd) { return ring_.tryPop(cmd); }
+    bool isEmpty() const { return ring_.isEmpty(); }
+
+    // Producer time spent waiting for space
+    uint32_t getStallUs() const { return stallUs_; }
+
+private:
+    SpscRing<DrawCommand, CAPACITY> ring_;
+    uint32_t stallUs_ = 0;
+};
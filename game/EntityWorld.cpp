@@ -0,0 +1,273 @@
+#include "EntityWorld.hpp"
+#include "GameObject.hpp"
+
+EntityWorld::EntityWorld(uint16_t capacity)
+    : capacity_(capacity), count_(0),
+      x_(new Scalar[capacity]), y_(new Scalar[capacity]),
+      vx_(new Scalar[capacity]), vy_(new Scalar[capacity]),
+      width_(new uint16_t[capacity]), height_(new uint16_t[capacity]),
+      bitmap_(new const uint8_t*[capacity]), color_(new uint16_t[capacity]),
+      flags_(new uint8_t[capacity]), bounds_(new Rect[capacity]),
+      drawnBounds_(new Rect[capacity]), ids_(new uint32_t[capacity]) {}
+
+uint32_t EntityWorld::create(const Vector2& position, uint16_t width, uint16_t height) {
+    if (count_ >= capacity_) return INVALID;
+
+    uint16_t i = count_++;
+    x_[i] = position.x;
+    y_[i] = position.y;
+    vx_[i] = Scalar(0);
+    vy_[i] = Scalar(0);
+    width_[i] = width;
+    height_[i] = height;
+    bitmap_[i] = nullptr;
+    color_[i] = 0xFFFF;
+    flags_[i] = FLAG_ACTIVE | FLAG_VISIBLE;
+    ids_[i] = handles_.allocate(i);
+    computeBounds(i);
+    return ids_[i];
+}
+
+void EntityWorld::destroy(uint32_t id) {
+    uint16_t i;
+    if (getIndex(id, i)) destroyAt(i);
+}
+
+void EntityWorld::destroyAll() {
+    for (uint16_t i = 0; i < count_; i++) {
+        destroyAt(i);
+    }
+}
+
+bool EntityWorld::isAlive(uint32_t id) const {
+    uint16_t i;
+    return getIndex(id, i) && (flags_[i] & FLAG_ACTIVE);
+}
+
+bool EntityWorld::getIndex(uint32_t id, uint16_t& index) const {
+    return handles_.lookup(id, index) && index < count_ && ids_[index] == id;
+}
+
+Vector2 EntityWorld::getPosition(uint32_t id) const {
+    uint16_t i;
+    return getIndex(id, i) ? Vector2(x_[i], y_[i]) : Vector2();
+}
+
+Vector2 EntityWorld::getVelocity(uint32_t id) const {
+    uint16_t i;
+    return getIndex(id, i) ? Vector2(vx_[i], vy_[i]) : Vector2();
+}
+
+void EntityWorld::setPosition(uint32_t id, const Vector2& position) {
+    uint16_t i;
+    if (!getIndex(id, i)) return;
+    x_[i] = position.x;
+    y_[i] = position.y;
+    computeBounds(i);
+}
+
+void EntityWorld::setVelocity(uint32_t id, const Vector2& velocity) {
+    uint16_t i;
+    if (!getIndex(id, i)) return;
+    vx_[i] = velocity.x;
+    vy_[i] = velocity.y;
+}
+
+void EntityWorld::setVisible(uint32_t id, bool visible) {
+    uint16_t i;
+    if (!getIndex(id, i)) return;
+    if (visible) {
+        flags_[i] |= FLAG_VISIBLE;
+    } else {
+        flags_[i] &= ~FLAG_VISIBLE;
+    }
+}
+
+void EntityWorld::setSprite(uint32_t id, const uint8_t* bitmap, uint16_t transparentColor) {
+    uint16_t i;
+    if (!getIndex(id, i)) return;
+    bitmap_[i] = bitmap;
+    color_[i] = transparentColor;
+    flags_[i] &= ~FLAG_DRAWN;  // Force a redraw
+}
+
+void EntityWorld::setColor(uint32_t id, uint16_t color) {
+    uint16_t i;
+    if (!getIndex(id, i)) return;
+    bitmap_[i] = nullptr;
+    color_[i] = color;
+    flags_[i] &= ~FLAG_DRAWN;
+}
+
+void EntityWorld::integrate(Scalar deltaTime) {
+    Scalar* x = x_.get();
+    Scalar* y = y_.get();
+    const Scalar* vx = vx_.get();
+    const Scalar* vy = vy_.get();
+    const uint8_t* flags = flags_.get();
+
+    for (uint16_t i = 0; i < count_; i++) {
+        if (!(flags[i] & FLAG_ACTIVE)) continue;
+        x[i] += vx[i] * deltaTime;
+        y[i] += vy[i] * deltaTime;
+    }
+    refreshBounds();
+}
+
+void EntityWorld::refreshBounds() {
+    for (uint16_t i = 0; i < count_; i++) {
+        computeBounds(i);
+    }
+}
+
+void EntityWorld::insertColliders(SpatialHash& grid, uint16_t idBase) const {
+    for (uint16_t i = 0; i < count_; i++) {
+        if (flags_[i] & FLAG_ACTIVE) {
+            grid.insert(idBase + i, bounds_[i]);
+        }
+    }
+}
+
+bool EntityWorld::overlaps(uint16_t a, uint16_t b) const {
+    if (!(flags_[a] & flags_[b] & FLAG_ACTIVE)) return false;
+
+    return x_[a] < x_[b] + Scalar(width_[b]) && x_[a] + Scalar(width_[a]) > x_[b] &&
+           y_[a] < y_[b] + Scalar(height_[b]) && y_[a] + Scalar(height_[a]) > y_[b];
+}
+
+bool EntityWorld::overlaps(uint16_t index, const GameObject& obj) const {
+    if (!(flags_[index] & FLAG_ACTIVE) || !obj.isActive()) return false;
+
+    Vector2 min, max;
+    obj.getCollider().getBounds(obj.getPosition(), min, max);
+    return x_[index] < max.x && x_[index] + Scalar(width_[index]) > min.x &&
+           y_[index] < max.y && y_[index] + Scalar(height_[index]) > min.y;
+}
+
+void EntityWorld::collectDirty(DirtyRegion& region) {
+    for (uint16_t i = 0; i < count_; i++) {
+        if (!(flags_[i] & FLAG_ACTIVE)) continue;
+
+        if (!(flags_[i] & FLAG_VISIBLE)) {
+            eraseAt(i, region);
+            continue;
+        }
+
+        if (!(flags_[i] & FLAG_DRAWN) || bounds_[i] != drawnBounds_[i]) {
+            eraseAt(i, region);
+            region.add(bounds_[i]);
+        }
+    }
+}
+
+bool EntityWorld::growDirty(DirtyRegion& region) const {
+    bool grew = false;
+    for (uint16_t i = 0; i < count_; i++) {
+        if (!isShown(i)) continue;
+
+        Rect bounds = bounds_[i].clipped(region.getBounds());
+        if (bounds.isEmpty()) continue;
+
+        if (region.intersects(bounds) && !region.contains(bounds)) {
+            region.add(bounds);
+            grew = true;
+        }
+    }
+    return grew;
+}
+
+uint16_t EntityWorld::render(Renderer& renderer) {
+    uint16_t drawn = 0;
+    for (uint16_t i = 0; i < count_; i++) {
+        if (!isShown(i)) continue;
+        drawAt(renderer, i);
+        drawnBounds_[i] = bounds_[i];
+        flags_[i] |= FLAG_DRAWN;
+        drawn++;
+    }
+    return drawn;
+}
+
+uint16_t EntityWorld::render(Renderer& renderer, const DirtyRegion& region) {
+    uint16_t drawn = 0;
+    for (uint16_t i = 0; i < count_; i++) {
+        if (!isShown(i) || !region.intersects(bounds_[i])) continue;
+        drawAt(renderer, i);
+        drawnBounds_[i] = bounds_[i];
+        flags_[i] |= FLAG_DRAWN;
+        drawn++;
+    }
+    return drawn;
+}
+
+uint16_t EntityWorld::renderBand(Renderer& renderer, const Rect& band) const {
+    uint16_t drawn = 0;
+    for (uint16_t i = 0; i < count_; i++) {
+        if (!isShown(i) || !band.intersects(bounds_[i])) continue;
+        drawAt(renderer, i);
+        drawn++;
+    }
+    return drawn;
+}
+
+void EntityWorld::markDrawn() {
+    for (uint16_t i = 0; i < count_; i++) {
+        if (isShown(i)) {
+            drawnBounds_[i] = bounds_[i];
+            flags_[i] |= FLAG_DRAWN;
+        }
+    }
+}
+
+void EntityWorld::removeInactive(DirtyRegion& region) {
+    for (uint16_t i = 0; i < count_;) {
+        if (flags_[i] & FLAG_ACTIVE) {
+            i++;
+            continue;
+        }
+
+        eraseAt(i, region);
+        handles_.release(ids_[i]);
+
+        // Swap-and-pop every component array
+        uint16_t last = --count_;
+        if (i != last) {
+            x_[i] = x_[last];
+            y_[i] = y_[last];
+            vx_[i] = vx_[last];
+            vy_[i] = vy_[last];
+            width_[i] = width_[last];
+            height_[i] = height_[last];
+            bitmap_[i] = bitmap_[last];
+            color_[i] = color_[last];
+            flags_[i] = flags_[last];
+            bounds_[i] = bounds_[last];
+            drawnBounds_[i] = drawnBounds_[last];
+            ids_[i] = ids_[last];
+            handles_.move(ids_[i], i);
+        }
+    }
+}
+
+void EntityWorld::computeBounds(uint16_t index) {
+    bounds_[index] = Rect::fromBounds(Vector2(x_[index], y_[index]),
+                                      Vector2(x_[index] + Scalar(width_[index]),
+                                              y_[index] + Scalar(height_[index])));
+}
+
+void EntityWorld::drawAt(Renderer& renderer, uint16_t index) const {
+    const Rect& r = bounds_[index];
+    if (bitmap_[index]) {
+        renderer.blitTransparent(r.x0, r.y0, width_[index], height_[index],
+                                 bitmap_[index], color_[index]);
+    } else {
+        renderer.fillRect(r.x0, r.y0, width_[index], height_[index], color_[index]);
+    }
+}
+
+void EntityWorld::eraseAt(uint16_t index, DirtyRegion& region) {
+    if (flags_[index] & FLAG_DRAWN) {
+        region.add(drawnBounds_[index]);
+        flags_[index] &= ~FLAG_DRAWN;
+    }
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include "Vector.hpp"
+#include "Rect.hpp"
+#include "HandleTable.hpp"
+#include "DirtyRegion.hpp"
+#include "SpatialHash.hpp"
+#include "Renderer.hpp"
+
+class GameObject;
+
+// Structure-of-arrays storage for lightweight entities (Game::enableEntities).
+//
+// An entity is a box with a position, velocity and either a sprite or a fill
+// color. Each component lives in its own parallel array, so the systems below
+// (integrate, collide, render) are tight loops over contiguous memory with no
+// virtual calls or pointer chasing. Per-entity behaviour goes in
+// Game::onUpdate, working on the arrays directly.
+//
+// Entities use the same dense layout as the scene: ids are generation-tagged
+// handles, and removal moves the last entity into the freed index.
+class EntityWorld {
+public:
+    static constexpr uint32_t INVALID = HandleTable::INVALID;
+
+    // All component arrays are allocated here, once
+    explicit EntityWorld(uint16_t capacity);
+
+    // New active, visible entity with a white fill; INVALID when full
+    uint32_t create(const Vector2& position, uint16_t width, uint16_t height);
+
+    // Deactivate; the entity is erased and removed by the next update
+    void destroy(uint32_t id);
+
+    // Deactivate every entity
+    void destroyAll();
+
+    bool isAlive(uint32_t id) const;
+
+    // Per-entity access by id (no effect for stale ids)
+    Vector2 getPosition(uint32_t id) const;
+    Vector2 getVelocity(uint32_t id) const;
+    void setPosition(uint32_t id, const Vector2& position);
+    void setVelocity(uint32_t id, const Vector2& velocity);
+    void setVisible(uint32_t id, bool visible);
+
+    // Draw as a sprite (big-endian RGB565, transparentColor skipped) sized
+    // like the entity, or as a solid box
+    void setSprite(uint32_t id, const uint8_t* bitmap, uint16_t transparentColor = 0x0000);
+    void setColor(uint32_t id, uint16_t color);
+
+    // Raw component arrays for custom systems, indexed 0..getCount()-1.
+    // Call refreshBounds() after moving entities through them.
+    uint16_t getCount() const { return count_; }
+    uint16_t getCapacity() const { return capacity_; }
+    Scalar* getPositionsX() { return x_.get(); }
+    Scalar* getPositionsY() { return y_.get(); }
+    Scalar* getVelocitiesX() { return vx_.get(); }
+    Scalar* getVelocitiesY() { return vy_.get(); }
+    uint32_t getIdAt(uint16_t index) const { return ids_[index]; }
+    bool isActiveAt(uint16_t index) const { return flags_[index] & FLAG_ACTIVE; }
+    void destroyAt(uint16_t index) { flags_[index] &= ~FLAG_ACTIVE; }
+
+    // Index of a live entity; false for stale ids
+    bool getIndex(uint32_t id, uint16_t& index) const;
+
+    // ===== Systems (run by Game) =====
+
+    // position += velocity * deltaTime for every active entity
+    void integrate(Scalar deltaTime);
+
+    // Recompute screen bounds from positions
+    void refreshBounds();
+
+    // Add active entities to the broadphase as ids idBase + index
+    void insertColliders(SpatialHash& grid, uint16_t idBase) const;
+
+    // Narrowphase box tests, matching BoxCollider::intersects
+    bool overlaps(uint16_t a, uint16_t b) const;
+    bool overlaps(uint16_t index, const GameObject& obj) const;
+
+    // Dirty-rect tracking, mirroring Game's handling of GameObjects
+    void collectDirty(DirtyRegion& region);
+    bool growDirty(DirtyRegion& region) const;
+
+    // Draw visible entities: all of them, those touching the region, or
+    // those touching a band (the last does not mark them drawn)
+    uint16_t render(Renderer& renderer);
+    uint16_t render(Renderer& renderer, const DirtyRegion& region);
+    uint16_t renderBand(Renderer& renderer, const Rect& band) const;
+    void markDrawn();
+
+    // Erase and remove inactive entities
+    void removeInactive(DirtyRegion& region);
+
+private:
+    static constexpr uint8_t FLAG_ACTIVE = 1 << 0;
+    static constexpr uint8_t FLAG_VISIBLE = 1 << 1;
+    static constexpr uint8_t FLAG_DRAWN = 1 << 2;
+
+    uint16_t capacity_;
+    uint16_t count_;
+    HandleTable handles_;
+
+    std::unique_ptr<Scalar[]> x_, y_;
+    std::unique_ptr<Scalar[]> vx_, vy_;
+    std::unique_ptr<uint16_t[]> width_, height_;
+    std::unique_ptr<const uint8_t*[]> bitmap_;
+    std::unique_ptr<uint16_t[]> color_;      // Fill color, or transparent color with a bitmap
+    std::unique_ptr<uint8_t[]> flags_;
+    std::unique_ptr<Rect[]> bounds_;
+    std::unique_ptr<Rect[]> drawnBounds_;
+    std::unique_ptr<uint32_t[]> ids_;
+
+    void computeBounds(uint16_t index);
+    void drawAt(Renderer& renderer, uint16_t index) const;
+    void eraseAt(uint16_t index, DirtyRegion& region);
+    bool isShown(uint16_t index) const {
+        return (flags_[index] & (FLAG_ACTIVE | FLAG_VISIBLE)) == (FLAG_ACTIVE | FLAG_VISIBLE);
+    }
+};
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdint>
+#include <concepts>
+#include <compare>
+
+// Q16.16 fixed-point number: 16 integer bits (-32768..32767), 16 fraction bits.
+//
+// The Cortex-M0+ has no FPU, so every float operation is a soft-float
+// library call; these are plain integer adds, shifts and multiplies.
+// Converts implicitly from integers and floats (constant-folded for
+// literals) and explicitly back.
+class Fixed {
+public:
+    static constexpr int FRACTION_BITS = 16;
+    static constexpr int32_t ONE = 1 << FRACTION_BITS;
+
+    constexpr Fixed() : raw_(0) {}
+
+    template <std::integral I>
+    constexpr Fixed(I value) : raw_((int32_t)value * ONE) {}
+
+    constexpr Fixed(float value)
+        : raw_((int32_t)(value * ONE + (value >= 0.0f ? 0.5f : -0.5f))) {}
+
+    constexpr Fixed(double value)
+        : raw_((int32_t)(value * ONE + (value >= 0.0 ? 0.5 : -0.5))) {}
+
+    static constexpr Fixed fromRaw(int32_t raw) {
+        Fixed f;
+        f.raw_ = raw;
+        return f;
+    }
+
+    constexpr int32_t raw() const { return raw_; }
+
+    // Truncates toward zero, like a float-to-int cast
+    template <std::integral I>
+    constexpr explicit operator I() const {
+        return (I)(raw_ >= 0 ? raw_ >> FRACTION_BITS : -(-raw_ >> FRACTION_BITS));
+    }
+
+    constexpr explicit operator float() const { return (float)raw_ / ONE; }
+
+    constexpr int32_t floorToInt() const { return raw_ >> FRACTION_BITS; }
+    constexpr int32_t ceilToInt() const { return (raw_ + ONE - 1) >> FRACTION_BITS; }
+
+    constexpr Fixed operator-() const { return fromRaw(-raw_); }
+
+    constexpr Fixed& operator+=(Fixed other) { raw_ += other.raw_; return *this; }
+    constexpr Fixed& operator-=(Fixed other) { raw_ -= other.raw_; return *this; }
+    constexpr Fixed& operator*=(Fixed other) { return *this = *this * other; }
+    constexpr Fixed& operator/=(Fixed other) { return *this = *this / other; }
+
+    friend constexpr Fixed operator+(Fixed a, Fixed b) { return fromRaw(a.raw_ + b.raw_); }
+    friend constexpr Fixed operator-(Fixed a, Fixed b) { return fromRaw(a.raw_ - b.raw_); }
+
+    friend constexpr Fixed operator*(Fixed a, Fixed b) {
+        return fromRaw((int32_t)(((int64_t)a.raw_ * b.raw_) >> FRACTION_BITS));
+    }
+
+    // Division by zero saturates instead of trapping
+    friend constexpr Fixed operator/(Fixed a, Fixed b) {
+        if (b.raw_ == 0) return fromRaw(a.raw_ >= 0 ? INT32_MAX : INT32_MIN);
+        return fromRaw((int32_t)(((int64_t)a.raw_ << FRACTION_BITS) / b.raw_));
+    }
+
+    friend constexpr bool operator==(Fixed a, Fixed b) = default;
+    friend constexpr auto operator<=>(Fixed a, Fixed b) = default;
+
+    // sqrt(x * x + y * y) computed on the raw values, so it cannot overflow
+    // even when x * x would
+    static Fixed hypot(Fixed x, Fixed y);
+
+    static Fixed sqrt(Fixed value);
+
+    // 1 / value by Newton-Raphson, avoiding a 64-bit divide
+    static Fixed reciprocal(Fixed value);
+
+private:
+    int32_t raw_;
+};
+
+namespace fixed_detail {
+
+// floor(sqrt(value)), one result bit per iteration
+inline uint32_t isqrt64(uint64_t value) {
+    uint64_t result = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)result;
+}
+
+} // namespace fixed_detail
+
+inline Fixed Fixed::hypot(Fixed x, Fixed y) {
+    // sqrt(xr^2 + yr^2) of raw values is already the Q16.16 result
+    uint64_t sum = (uint64_t)((int64_t)x.raw_ * x.raw_) + (uint64_t)((int64_t)y.raw_ * y.raw_);
+    uint32_t root = fixed_detail::isqrt64(sum);
+    return fromRaw(root > INT32_MAX ? INT32_MAX : (int32_t)root);
+}
+
+inline Fixed Fixed::sqrt(Fixed value) {
+    if (value.raw_ <= 0) return Fixed();
+    return fromRaw((int32_t)fixed_detail::isqrt64((uint64_t)value.raw_ << FRACTION_BITS));
+}
+
+inline Fixed Fixed::reciprocal(Fixed value) {
+    if (value.raw_ == 0) return fromRaw(INT32_MAX);
+
+    bool negative = value.raw_ < 0;
+    uint32_t d = negative ? -(uint32_t)value.raw_ : (uint32_t)value.raw_;
+
+    // Scale d into [0.5, 1) as Q0.32, then iterate x = x * (2 - d * x) in
+    // Q2.30 from the usual linear first guess 48/17 - 32/17 * d. Each step
+    // doubles the correct bits: 4 -> 8 -> 16 -> 32.
+    int shift = __builtin_clz(d);
+    uint32_t dn = d << shift;
+    uint32_t x = 0xB4B4B4B4u - (uint32_t)(((uint64_t)dn * 0x78787878u) >> 32);
+    for (int i = 0; i < 3; i++) {
+        uint32_t dx = (uint32_t)(((uint64_t)dn * x) >> 32);   // d * x, Q2.30
+        uint32_t e = 0x80000000u - dx;                        // 2 - d * x
+        x = (uint32_t)(((uint64_t)x * e) >> 30);
+    }
+
+    // value = dn * 2^(16 - shift), so 1 / value in Q16.16 is x * 2^(shift - 30)
+    uint64_t result = shift >= 30 ? (uint64_t)x << (shift - 30) : x >> (30 - shift);
+    if (result > INT32_MAX) result = INT32_MAX;
+    return fromRaw(negative ? -(int32_t)result : (int32_t)result);
+}
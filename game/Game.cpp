@@ -3,18 +3,98 @@
 #include "pico/stdlib.h"
 
 Game::Game(Screen& scr)
-    : screen(scr), running(true), deltaTime(0.016f), frameCount(0) {}
+    : screen(scr), renderer(scr.display(), Screen::WIDTH, Screen::HEIGHT), running(true), deltaTime(0.016667f),
+      stepDelta(0.016667f), frameCount(0),
+      renderMode(RenderMode::DirtyRects), backgroundColor(0x0000),
+      dirtyRegion(Rect(0, 0, Screen::WIDTH, Screen::HEIGHT)), frameFence(0), renderWaitUs(0),
+      collisionGrid(Screen::WIDTH, Screen::HEIGHT), framePeriodUs(16667), stepUs(16667),
+      maxCatchUpSteps(4), fpsWindowStart(0), fpsWindowFrames(0),
+      profilerOverlay(false), profilerDumpInterval(0), scrolling(false), scrollTop(0),
+      scrollHeight(Screen::HEIGHT), scrollY(0), scrollShownY(0), viewCount(1),
+      tileMap(nullptr) {
+    renderer.setDmaEnabled(screen.isDmaReady());
+}
 
 void Game::run() {
     onInit();
 
+    // Whatever onInit() left on screen is stale for dirty-rect tracking
+    invalidateAll();
+
+    uint64_t previous = time_us_64();
+    uint64_t deadline = previous + framePeriodUs;
+    uint32_t accumulator = stepUs;  // Update once before the first render
+    fpsWindowStart = previous;
+    fpsWindowFrames = 0;
+
     while (running) {
-        update();
+        uint64_t frameStart = time_us_64();
+        uint32_t frameUs = (uint32_t)(frameStart - previous);
+        previous = frameStart;
+        accumulator += frameUs;
+
+        if (frameCount > 0) {
+            frameTiming.lastFrameUs = frameUs;
+            frameTiming.worstFrameUs = std::max(frameTiming.worstFrameUs, frameUs);
+        }
+
+        // Consume elapsed time in fixed steps, dropping what the cap can't cover
+        uint8_t steps = 0;
+        while (accumulator >= stepUs && running) {
+            if (steps == maxCatchUpSteps) {
+                frameTiming.droppedSteps += accumulator / stepUs;
+                accumulator %= stepUs;
+                break;
+            }
+            update();
+            accumulator -= stepUs;
+            steps++;
+        }
+        frameTiming.lastUpdateSteps = steps;
+
         render();
         frameCount++;
-        sleep_ms(16);  // ~60 FPS
+
+        uint64_t workEnd = time_us_64();
+        frameTiming.lastWorkUs = (uint32_t)(workEnd - frameStart);
+
+        PROFILE_ADD(profiler, ProfilePhase::Frame, frameTiming.lastWorkUs);
+
+        // Outside the Frame phase: drawing waits for core1 and the DMA queue
+        // to drain, and that stall is charged to Overlay instead
+        if (profilerOverlayDue) {
+            PROFILE_SCOPE(profiler, ProfilePhase::Overlay);
+            drawProfilerOverlay();
+            profilerOverlayDue = false;
+        }
+        PROFILE_END_FRAME(profiler);
+        if (profilerDumpInterval && frameCount % profilerDumpInterval == 0) {
+            profiler.dump();
+        }
+
+        // Sleep off the rest of the frame budget; after an overrun, restart
+        // the schedule from now rather than rushing frames to catch up
+        if (workEnd < deadline) {
+            sleep_until(from_us_since_boot(deadline));
+            deadline += framePeriodUs;
+        } else {
+            frameTiming.missedDeadlines++;
+            deadline = workEnd + framePeriodUs;
+        }
+
+        core0Usage.busyUs += frameTiming.lastWorkUs - renderWaitUs;
+        core0Usage.idleUs += (uint32_t)(time_us_64() - workEnd) + renderWaitUs;
+
+        fpsWindowFrames++;
+        uint64_t windowUs = time_us_64() - fpsWindowStart;
+        if (windowUs >= 1000000) {
+            frameTiming.fps = fpsWindowFrames * 1000000.0f / windowUs;
+            fpsWindowStart += windowUs;
+            fpsWindowFrames = 0;
+        }
     }
 
+    waitForDisplay();
     onShutdown();
 }
 
@@ -30,142 +110,552 @@ uint32_t Game::getFrameCount() const {
     return frameCount;
 }
 
+void Game::setTargetFps(uint16_t fps) {
+    if (fps == 0) return;
+    framePeriodUs = 1000000 / fps;
+    setFixedTimestep(framePeriodUs);
+}
+
+void Game::setFixedTimestep(uint32_t us) {
+    if (us == 0) return;
+    stepUs = us;
+    deltaTime = us / 1000000.0f;
+    stepDelta = Scalar(deltaTime);
+}
+
+uint32_t Game::getFixedTimestep() const {
+    return stepUs;
+}
+
+void Game::setMaxCatchUpSteps(uint8_t steps) {
+    maxCatchUpSteps = steps > 0 ? steps : 1;
+}
+
+const FrameTiming& Game::getFrameTiming() const {
+    return frameTiming;
+}
+
+Profiler& Game::getProfiler() {
+    return profiler;
+}
+
+void Game::setProfilerOverlay(bool enabled) {
+    profilerOverlay = enabled && PICO_GAME_PROFILE;
+    if (!profilerOverlay) {
+        // Let the game repaint the area the overlay covered
+        Rect overlay = Profiler::getOverlayRect(0, 0);
+        invalidate(Screen::WIDTH - overlay.width(), 0, overlay.width(), overlay.height());
+    }
+}
+
+void Game::setProfilerDump(uint16_t frames) {
+    profilerDumpInterval = PICO_GAME_PROFILE ? frames : 0;
+}
+
+void Game::resetFrameTiming() {
+    float fps = frameTiming.fps;
+    frameTiming = FrameTiming();
+    frameTiming.fps = fps;
+}
+
 void Game::update() {
+    PROFILE_SCOPE(profiler, ProfilePhase::Update);
+
     onUpdate(deltaTime);
 
     // Update all active game objects
+    GameObject::stepSeconds = deltaTime;
+    GameObject::stepScalar = stepDelta;
     for (auto& obj : gameObjects) {
         if (obj->isActive()) {
             obj->update(deltaTime);
         }
     }
 
+    if (entities) {
+        entities->integrate(stepDelta);
+    }
+
     // Check collisions between all active objects
     checkCollisions();
 
-    // Remove inactive objects
-    gameObjects.erase(
-        std::remove_if(gameObjects.begin(), gameObjects.end(),
-                       [](const std::unique_ptr<GameObject>& obj) { return !obj->isActive(); }),
-        gameObjects.end()
-    );
+    // Remove inactive objects, clearing wherever they were last drawn
+    for (size_t i = 0; i < gameObjects.size();) {
+        if (!gameObjects[i]->isActive()) {
+            eraseObject(*gameObjects[i]);
+            removeAt(i);  // Re-check index i, it now holds the moved object
+        } else {
+            i++;
+        }
+    }
+    if (entities) {
+        entities->removeInactive(dirtyRegion);
+    }
 }
 
 void Game::render() {
-    // Clear display
-    screen.display().fillScreen(0x0000); // Black
+    PROFILE_SCOPE(profiler, ProfilePhase::Render);
+
+    // Keep at most one frame in flight: frame N finishes sending while
+    // update() for N+1 runs, and must be out before N+1 is queued. Core1
+    // replays commands in order, so there N+1 may be recorded while N is
+    // still being drawn (two frames in the queue, double buffering).
+    uint32_t waitStart = time_us_32();
+    uint32_t stallStart = renderCore ? renderCore->getQueue().getStallUs() : 0;
+    if (renderCore) {
+        renderCore->waitForFrames(1);
+    } else {
+        renderer.wait(frameFence);
+    }
+    renderWaitUs = time_us_32() - waitStart;
+    PROFILE_ADD(profiler, ProfilePhase::DisplayWait, renderWaitUs);
+
+    renderStats = RenderStats();
+    renderer.resetStats();
+    beginViews();
+
+    switch (renderMode) {
+        case RenderMode::FullClear:
+            renderFullClear();
+            break;
+        case RenderMode::DirtyRects:
+            renderDirtyRects();
+            break;
+        case RenderMode::Strips:
+            renderStrips();
+            break;
+    }
 
-    // Call user-defined rendering
-    onRender();
+    renderer.resetView();
+    if (scrolling && scrollShownY != scrollY) {
+        // Queued behind the frame, so the uncovered rows are drawn first
+        int16_t phase = ((scrollY % scrollHeight) + scrollHeight) % scrollHeight;
+        screen.setScrollStart(scrollTop + phase);
+        scrollShownY = scrollY;
+    }
+
+    if (renderCore) {
+        renderCore->endFrame();
+        renderStats.bytesSent = renderCore->getLastFrameBytes();
+        renderWaitUs += renderCore->getQueue().getStallUs() - stallStart;
+    } else {
+        renderStats.bytesSent = renderer.getBytesSent();
+    }
+    frameFence = renderer.fence();
+
+    profilerOverlayDue = profilerOverlay && isProfilerOverlayDue();
+    dirtyRegion.clear();
+}
+
+Rect Game::getProfilerOverlayRect() const {
+    Rect overlay = Profiler::getOverlayRect(0, 0);
+    return Profiler::getOverlayRect(Screen::WIDTH - overlay.width(), 0);
+}
+
+void Game::drawProfilerOverlay() {
+    Rect overlay = getProfilerOverlayRect();
+    profiler.drawOverlay(getDisplay(), overlay.x0, overlay.y0, frameTiming.fps);
+}
+
+bool Game::isProfilerOverlayDue() const {
+    Rect overlay = getProfilerOverlayRect();
+
+    // The window's rows move in frame memory; only the fixed rows above it
+    // hold still
+    if (scrolling) {
+        return overlay.y1 <= scrollTop && frameCount % PROFILER_OVERLAY_REFRESH == 0;
+    }
+
+    // dirtyRegion still holds what this frame repainted
+    bool paintedOver;
+    switch (renderMode) {
+        case RenderMode::FullClear:
+            paintedOver = true;
+            break;
+        case RenderMode::Strips:
+            paintedOver = false;
+            for (int16_t i = 0; i < compositor->getBandCount(); i++) {
+                Rect band = compositor->getBandRect(i);
+                if (band.intersects(overlay) && dirtyRegion.intersects(band)) {
+                    paintedOver = true;
+                }
+            }
+            break;
+        default:
+            paintedOver = dirtyRegion.intersects(overlay);
+            break;
+    }
+
+    return paintedOver || frameCount % PROFILER_OVERLAY_REFRESH == 0;
+}
+
+void Game::renderFullClear() {
+    renderStats.dirtyRects = 1;
+    dirtyRegion.clear();
+
+    // Objects are drawn through every view, but counted once
+    for (uint8_t v = 0; v < viewCount; v++) {
+        // Clear display
+        clearArea(getWorldView(), v);
+        selectView(v);
+
+        if (!scrolling) {
+            renderUser();
+        }
+
+        // Render all visible game objects
+        for (auto& obj : gameObjects) {
+            if (obj->isActive() && obj->isVisible()) {
+                if (v == 0) {
+                    drawObject(*obj);
+                } else {
+                    obj->render(renderer);
+                }
+            }
+        }
+        if (entities) {
+            uint16_t drawn = entities->render(renderer);
+            if (v == 0) renderStats.objectsDrawn += drawn;
+        }
+    }
+
+    if (scrolling) {
+        renderer.resetView();
+        renderUser();
+    }
+}
+
+void Game::collectDirtyObjects() {
+    for (auto& obj : gameObjects) {
+        if (!obj->isActive()) continue;
+
+        if (!obj->isVisible()) {
+            eraseObject(*obj);
+            continue;
+        }
+
+        Rect bounds = obj->getRenderBounds();
+        if (!obj->drawn || bounds != obj->drawnBounds) {
+            eraseObject(*obj);
+            dirtyRegion.add(bounds);
+        }
+    }
+    if (entities) {
+        entities->collectDirty(dirtyRegion);
+    }
+}
+
+void Game::renderDirtyRects() {
+    collectDirtyObjects();
+
+    // Clearing a rect wipes any object overlapping it, so that object's full
+    // bounds must be redrawn too; repeat until no new area is pulled in
+    const Rect& screenRect = dirtyRegion.getBounds();
+    bool grew = !dirtyRegion.isEmpty();
+    while (grew) {
+        grew = false;
+        for (auto& obj : gameObjects) {
+            if (!obj->isActive() || !obj->isVisible()) continue;
+
+            Rect bounds = obj->getRenderBounds().clipped(screenRect);
+            if (bounds.isEmpty()) continue;
+
+            if (dirtyRegion.intersects(bounds) && !dirtyRegion.contains(bounds)) {
+                dirtyRegion.add(bounds);
+                grew = true;
+            }
+        }
+        if (entities && entities->growDirty(dirtyRegion)) {
+            grew = true;
+        }
+    }
+
+    renderStats.dirtyRects = dirtyRegion.count();
+
+    for (uint8_t v = 0; v < viewCount; v++) {
+        for (size_t i = 0; i < dirtyRegion.count(); i++) {
+            clearArea(dirtyRegion[i], v);
+        }
+        selectView(v);
+
+        if (!scrolling) {
+            renderUser();
+        }
+
+        // Redraw only objects touching a cleared area
+        for (auto& obj : gameObjects) {
+            if (obj->isActive() && obj->isVisible() &&
+                dirtyRegion.intersects(obj->getRenderBounds())) {
+                if (v == 0) {
+                    drawObject(*obj);
+                } else {
+                    obj->render(renderer);
+                }
+            }
+        }
+        if (entities) {
+            uint16_t drawn = entities->render(renderer, dirtyRegion);
+            if (v == 0) renderStats.objectsDrawn += drawn;
+        }
+    }
+
+    if (scrolling) {
+        renderer.resetView();
+        renderUser();
+    }
+}
+
+void Game::renderStrips() {
+    collectDirtyObjects();
+
+    // A recomposed band is complete, so only bands touching a change are sent
+    for (int16_t i = 0; i < compositor->getBandCount(); i++) {
+        Rect band = compositor->getBandRect(i);
+        if (!dirtyRegion.intersects(band)) continue;
+
+        compositor->beginBand(i, backgroundColor);
+        if (tileMap) {
+            renderStats.tilesDrawn += tileMap->draw(renderer, band);
+        }
+        onRenderBackground(band);
+        renderUser();
+        for (auto& obj : gameObjects) {
+            if (obj->isActive() && obj->isVisible() && band.intersects(obj->getRenderBounds())) {
+                obj->render(renderer);
+                renderStats.objectsDrawn++;
+            }
+        }
+        if (entities) {
+            renderStats.objectsDrawn += entities->renderBand(renderer, band);
+        }
+        compositor->endBand();
+        renderStats.dirtyRects++;
+    }
 
-    // Render all visible game objects
     for (auto& obj : gameObjects) {
         if (obj->isActive() && obj->isVisible()) {
-            obj->render(screen.display());
+            obj->drawnBounds = obj->getRenderBounds();
+            obj->drawn = true;
         }
     }
+    if (entities) {
+        entities->markDrawn();
+    }
+}
+
+void Game::renderUser() {
+    PROFILE_SCOPE(profiler, ProfilePhase::OnRender);
+    onRender();
+}
+
+void Game::beginViews() {
+    Rect view = getWorldView();
+    if (scrolling) {
+        dirtyRegion.setBounds(view);
+    }
+    if (tileMap) {
+        tileMap->setView(view);
+        tileMap->collectDirty(dirtyRegion);
+    }
+
+    if (!scrolling) {
+        viewCount = 1;
+        viewOffset[0] = 0;
+        viewArea[0] = view;
+        return;
+    }
+
+    // Rows the window moved onto since the panel last scrolled
+    int32_t delta = (int32_t)scrollY - scrollShownY;
+    if (delta >= scrollHeight || -delta >= scrollHeight) {
+        dirtyRegion.addAll();
+    } else if (delta > 0) {
+        dirtyRegion.add(Rect(0, view.y1 - delta, Screen::WIDTH, view.y1));
+    } else if (delta < 0) {
+        dirtyRegion.add(Rect(0, view.y0, Screen::WIDTH, view.y0 - delta));
+    }
+
+    // World row w lives in frame memory row top + (w mod height). The window
+    // wraps around that ring, so it is drawn as up to two views.
+    int16_t phase = ((scrollY % scrollHeight) + scrollHeight) % scrollHeight;
+    viewOffset[0] = scrollTop + phase - scrollY;
+    viewArea[0] = Rect(0, scrollTop + phase, Screen::WIDTH, scrollTop + scrollHeight);
+    viewOffset[1] = viewOffset[0] - scrollHeight;
+    viewArea[1] = Rect(0, scrollTop, Screen::WIDTH, scrollTop + phase);
+    viewCount = phase > 0 ? 2 : 1;
+}
+
+void Game::selectView(uint8_t index) {
+    renderer.setView(0, viewOffset[index], viewArea[index]);
+}
+
+void Game::selectView(uint8_t index, const Rect& area) {
+    int16_t offset = viewOffset[index];
+    Rect target(area.x0, area.y0 + offset, area.x1, area.y1 + offset);
+    renderer.setView(0, offset, target.clipped(viewArea[index]));
+}
+
+void Game::clearArea(const Rect& area, uint8_t index) {
+    selectView(index, area);
+    if (!renderer.isRecording() && renderer.getClip().isEmpty()) return;
+
+    if (tileMap) {
+        renderStats.tilesDrawn += tileMap->draw(renderer, area);
+    } else {
+        renderer.fillRect(area.x0, area.y0, area.width(), area.height(), backgroundColor);
+    }
+    onRenderBackground(area);
+}
+
+void Game::drawObject(GameObject& obj) {
+    obj.render(renderer);
+    obj.drawnBounds = obj.getRenderBounds();
+    obj.drawn = true;
+    renderStats.objectsDrawn++;
+}
+
+void Game::eraseObject(GameObject& obj) {
+    if (obj.drawn) {
+        dirtyRegion.add(obj.drawnBounds);
+        obj.drawn = false;
+    }
 }
 
 void Game::checkCollisions() {
+    PROFILE_SCOPE(profiler, ProfilePhase::Collisions);
+
+    collisionGrid.clear();
+    collisionGrid.setOrigin(0, scrolling ? scrollY : 0);
     for (size_t i = 0; i < gameObjects.size(); i++) {
-        for (size_t j = i + 1; j < gameObjects.size(); j++) {
-            if (gameObjects[i]->isActive() && gameObjects[j]->isActive()) {
-                if (gameObjects[i]->collidesWith(*gameObjects[j])) {
-                    onCollision(*gameObjects[i], *gameObjects[j]);
-                }
+        if (gameObjects[i]->isActive()) {
+            collisionGrid.insert(i, gameObjects[i]->getScreenBounds());
+        }
+    }
+
+    // Entities follow the objects in the id space: id - objectCount is the
+    // entity index
+    uint16_t objectCount = gameObjects.size();
+    if (entities) {
+        entities->insertColliders(collisionGrid, objectCount);
+    }
+    collisionGrid.build();
+
+    collisionStats = CollisionStats();
+    collisionStats.objects = collisionGrid.getEntryCount();
+
+    // Indices stay valid during the pass: objects onCollision() adds join
+    // next frame, and objects it removes are only deactivated (so
+    // collidesWith() skips them) until the pass ends.
+    collisionPass = true;
+    collisionGrid.forEachPair([this, objectCount](uint16_t a, uint16_t b) {
+        if (b < objectCount) {
+            if (gameObjects[a]->collidesWith(*gameObjects[b])) {
+                collisionStats.collisions++;
+                onCollision(*gameObjects[a], *gameObjects[b]);
+            }
+        } else if (a < objectCount) {
+            uint16_t e = b - objectCount;
+            if (entities->overlaps(e, *gameObjects[a])) {
+                collisionStats.collisions++;
+                onEntityObjectCollision(entities->getIdAt(e), *gameObjects[a]);
+            }
+        } else {
+            uint16_t ea = a - objectCount;
+            uint16_t eb = b - objectCount;
+            if (entities->overlaps(ea, eb)) {
+                collisionStats.collisions++;
+                onEntityCollision(entities->getIdAt(ea), entities->getIdAt(eb));
             }
         }
+    });
+
+    collisionPass = false;
+
+    // Ids already removed (requested twice) are ignored
+    for (uint32_t id : pendingRemovals) {
+        removeGameObjectById(id);
     }
+    pendingRemovals.clear();
+
+    collisionStats.cellPairs = collisionGrid.getCellPairCount();
+    collisionStats.candidatePairs = collisionGrid.getCandidatePairCount();
 }
 
 void Game::renderSprite(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color) {
-    screen.display().fillRect(x, y, width, height, color);
+    renderer.fillRect(x, y, width, height, color);
 }
 
 void Game::renderSpriteOutline(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color) {
-    screen.display().drawRectWH(x, y, width, height, color);
+    renderer.drawRect(x, y, width, height, color);
 }
 
 void Game::renderCircle(uint16_t x, uint16_t y, uint16_t radius, uint16_t color) {
-    // Midpoint circle algorithm (outline)
-    int16_t xc = (int16_t)x;
-    int16_t yc = (int16_t)y;
-    int16_t r = (int16_t)radius;
-    int16_t dx = 0;
-    int16_t dy = r;
-    int16_t d = 1 - r;
-
-    auto plot8 = [&](int16_t px, int16_t py) {
-        screen.display().drawPixel((uint16_t)px, (uint16_t)py, color);
-    };
-
-    while (dx <= dy) {
-        plot8(xc + dx, yc + dy);
-        plot8(xc - dx, yc + dy);
-        plot8(xc + dx, yc - dy);
-        plot8(xc - dx, yc - dy);
-        plot8(xc + dy, yc + dx);
-        plot8(xc - dy, yc + dx);
-        plot8(xc + dy, yc - dx);
-        plot8(xc - dy, yc - dx);
-
-        dx++;
-        if (d < 0) {
-            d += 2 * dx + 1;
-        } else {
-            dy--;
-            d += 2 * (dx - dy) + 1;
-        }
-    }
+    renderer.drawCircle(x, y, radius, color);
 }
 
 void Game::renderFilledCircle(uint16_t centerX, uint16_t centerY, uint16_t radius, uint16_t color) {
-    for (int16_t y = -radius; y <= radius; y++) {
-        for (int16_t x = -radius; x <= radius; x++) {
-            if (x * x + y * y <= radius * radius) {
-                screen.display().drawPixel(centerX + x, centerY + y, color);
-            }
-        }
-    }
+    renderer.fillCircle(centerX, centerY, radius, color);
+}
+
+void Game::renderFilledTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                int16_t x2, int16_t y2, uint16_t color) {
+    renderer.fillTriangle(x0, y0, x1, y1, x2, y2, color);
+}
+
+void Game::renderFilledPolygon(const Point* points, uint8_t count, uint16_t color) {
+    renderer.fillPolygon(points, count, color);
 }
 
 void Game::renderLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color) {
-    screen.display().drawLine(x1, y1, x2, y2, color);
+    renderer.drawLine(x1, y1, x2, y2, color);
 }
 
 void Game::renderBitmap(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
                         const uint16_t* pixelData) {
-    for (uint16_t row = 0; row < height; row++) {
-        for (uint16_t col = 0; col < width; col++) {
-            uint16_t color = pixelData[row * width + col];
-            screen.display().drawPixel(x + col, y + row, color);
-        }
-    }
+    renderer.blit16(x, y, width, height, pixelData);
 }
 
 void Game::renderBitmapTransparent(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
                                    const uint16_t* pixelData, uint16_t transparentColor) {
-    for (uint16_t row = 0; row < height; row++) {
-        for (uint16_t col = 0; col < width; col++) {
-            uint16_t color = pixelData[row * width + col];
-            if (color != transparentColor) {
-                screen.display().drawPixel(x + col, y + row, color);
-            }
-        }
-    }
+    renderer.blit16Transparent(x, y, width, height, pixelData, transparentColor);
+}
+
+void Game::renderBitmap(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                        const uint8_t* wireData) {
+    renderer.blit(x, y, width, height, wireData);
+}
+
+void Game::renderBitmap(uint16_t x, uint16_t y, const MaskedBitmap& bitmap) {
+    renderer.blitMasked(x, y, bitmap);
 }
 
 void Game::addGameObject(std::unique_ptr<GameObject> obj) {
+    attachObject(GameObjectPtr(obj.release()));
+}
+
+void Game::attachObject(GameObjectPtr obj) {
+    obj->id = objectHandles.allocate(gameObjects.size());
     gameObjects.push_back(std::move(obj));
 }
 
+void Game::removeAt(size_t index) {
+    objectHandles.release(gameObjects[index]->id);
+
+    size_t last = gameObjects.size() - 1;
+    if (index != last) {
+        std::swap(gameObjects[index], gameObjects[last]);
+        objectHandles.move(gameObjects[index]->id, index);
+    }
+    gameObjects.pop_back();
+}
+
 GameObject* Game::findGameObject(uint32_t id) {
-    for (auto& obj : gameObjects) {
-        if (obj->getId() == id) {
-            return obj.get();
-        }
+    uint16_t index;
+    if (!objectHandles.lookup(id, index) || index >= gameObjects.size()) {
+        return nullptr;
     }
-    return nullptr;
+    GameObject* obj = gameObjects[index].get();
+    return obj->id == id ? obj : nullptr;
 }
 
 size_t Game::getGameObjectCount() const {
@@ -180,19 +670,231 @@ GameObject* Game::getGameObjectAt(size_t index) {
 }
 
 void Game::removeGameObject(size_t index) {
-    if (index < gameObjects.size()) {
-        gameObjects.erase(gameObjects.begin() + index);
+    if (index >= gameObjects.size()) return;
+
+    if (collisionPass) {
+        gameObjects[index]->setActive(false);
+        pendingRemovals.push_back(gameObjects[index]->id);
+        return;
+    }
+    eraseObject(*gameObjects[index]);
+    removeAt(index);
+}
+
+bool Game::removeGameObjectById(uint32_t id) {
+    uint16_t index;
+    if (!findGameObject(id) || !objectHandles.lookup(id, index)) {
+        return false;
     }
+    removeGameObject(index);
+    return true;
 }
 
 void Game::clearGameObjects() {
+    if (collisionPass) {
+        for (size_t i = 0; i < gameObjects.size(); i++) {
+            removeGameObject(i);
+        }
+        return;
+    }
+
+    for (auto& obj : gameObjects) {
+        eraseObject(*obj);
+        objectHandles.release(obj->id);
+    }
     gameObjects.clear();
 }
 
+void Game::setRenderMode(RenderMode mode) {
+    if (mode == renderMode) return;
+
+    renderMode = mode;
+    if (mode == RenderMode::Strips) {
+        // Bands are composed in RAM and pushed by core0's DMA queue, in
+        // screen coordinates
+        setDualCore(false);
+        disableScrolling();
+        compositor = std::make_unique<StripCompositor>(renderer);
+    } else {
+        compositor.reset();
+    }
+    invalidateAll();
+}
+
+RenderMode Game::getRenderMode() const {
+    return renderMode;
+}
+
+void Game::setBackgroundColor(uint16_t color) {
+    backgroundColor = color;
+    invalidateAll();
+}
+
+uint16_t Game::getBackgroundColor() const {
+    return backgroundColor;
+}
+
+void Game::invalidate(int16_t x, int16_t y, int16_t width, int16_t height) {
+    dirtyRegion.add(Rect::fromSize(x, y, width, height));
+}
+
+void Game::invalidateAll() {
+    dirtyRegion.addAll();
+}
+
+bool Game::enableScrolling(int16_t top, int16_t height) {
+    if (renderMode == RenderMode::Strips || top < 0 || height <= 0 ||
+        top + height > Screen::HEIGHT) {
+        return false;
+    }
+
+    // Core1 would need to send the scroll start in order with its frame
+    setDualCore(false);
+    waitForDisplay();
+
+    scrolling = true;
+    scrollTop = top;
+    scrollHeight = height;
+    scrollShownY = scrollY;
+    screen.setScrollArea(top, height);
+    screen.setScrollStart(top + ((scrollY % height) + height) % height);
+
+    // Frame memory no longer lines up with the world
+    dirtyRegion.clear();
+    dirtyRegion.setBounds(getWorldView());
+    invalidateAll();
+    return true;
+}
+
+void Game::disableScrolling() {
+    if (!scrolling) return;
+
+    waitForDisplay();
+    scrolling = false;
+    scrollTop = 0;
+    scrollHeight = Screen::HEIGHT;
+    screen.setScrollArea(0, Screen::HEIGHT);
+    screen.setScrollStart(0);
+
+    dirtyRegion.clear();
+    dirtyRegion.setBounds(getWorldView());
+    invalidateAll();
+}
+
+bool Game::isScrolling() const {
+    return scrolling;
+}
+
+void Game::setScrollY(int16_t y) {
+    scrollY = y;
+}
+
+int16_t Game::getScrollY() const {
+    return scrollY;
+}
+
+void Game::setTileMap(TileMap* map) {
+    tileMap = map;
+    dirtyRegion.setGrid(map ? map->getTileSize() : 1);
+    invalidateAll();
+}
+
+TileMap* Game::getTileMap() {
+    return tileMap;
+}
+
+Rect Game::getWorldView() const {
+    if (!scrolling) {
+        return Rect(0, 0, Screen::WIDTH, Screen::HEIGHT);
+    }
+    return Rect(0, scrollY, Screen::WIDTH, scrollY + scrollHeight);
+}
+
+const RenderStats& Game::getRenderStats() const {
+    return renderStats;
+}
+
+void Game::enableEntities(uint16_t capacity) {
+    if (!entities) {
+        entities = std::make_unique<EntityWorld>(capacity);
+    }
+}
+
+EntityWorld* Game::getEntities() {
+    return entities.get();
+}
+
+const CollisionStats& Game::getCollisionStats() const {
+    return collisionStats;
+}
+
+bool Game::setDualCore(bool enabled) {
+    if (enabled == isDualCore()) return true;
+
+    if (enabled) {
+        if (renderMode == RenderMode::Strips || scrolling) return false;
+
+        // Core1 owns the bus from here on; the DMA interrupt is core0's
+        renderer.waitIdle();
+        renderer.setDmaEnabled(false);
+        renderCore = std::make_unique<RenderCore>(screen.display(), Screen::WIDTH, Screen::HEIGHT);
+        renderCore->start();
+        renderer.setRecorder(&renderCore->getQueue());
+        core1Baseline = CoreUsage();
+    } else {
+        renderCore->stop();
+        renderer.setRecorder(nullptr);
+        renderCore.reset();
+        renderer.setDmaEnabled(screen.isDmaReady());
+    }
+    return true;
+}
+
+bool Game::isDualCore() const {
+    return renderCore != nullptr;
+}
+
+CoreUsage Game::getCoreUsage(uint8_t core) const {
+    if (core == 0) {
+        return core0Usage;
+    }
+
+    CoreUsage usage;
+    if (renderCore) {
+        CoreUsage total = renderCore->getUsage();
+        usage.busyUs = total.busyUs - core1Baseline.busyUs;
+        usage.idleUs = total.idleUs - core1Baseline.idleUs;
+    }
+    return usage;
+}
+
+void Game::resetCoreUsage() {
+    core0Usage = CoreUsage();
+    if (renderCore) {
+        core1Baseline = renderCore->getUsage();
+    }
+}
+
+display_dma_fence_t Game::getFrameFence() const {
+    return frameFence;
+}
+
+void Game::waitForDisplay() {
+    if (renderCore) {
+        renderCore->waitIdle();
+    }
+    renderer.waitIdle();
+}
+
+Renderer& Game::getRenderer() {
+    return renderer;
+}
+
 Screen& Game::getScreen() {
     return screen;
 }
 
 ILI9341_TFT& Game::getDisplay() {
-    return screen.display();
+    waitForDisplay();
+    return renderer.display();
 }
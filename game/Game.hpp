@@ -4,22 +4,114 @@
 #include <memory>
 #include <cstring>
 #include <cstdint>
+#include <type_traits>
 #include "Screen.hpp"
 #include "GameObject.hpp"
+#include "ObjectPool.hpp"
+#include "DirtyRegion.hpp"
+#include "Renderer.hpp"
+#include "StripCompositor.hpp"
+#include "RenderCore.hpp"
+#include "SpatialHash.hpp"
+#include "HandleTable.hpp"
+#include "EntityWorld.hpp"
+#include "TileMap.hpp"
+#include "Profiler.hpp"
+
+// How Game::render repaints the screen each frame
+enum class RenderMode {
+    FullClear,   // Clear the whole screen and redraw every object
+    DirtyRects,  // Clear and redraw only the areas objects moved through
+    Strips       // Compose changed bands off-screen and push each in one burst
+};
+
+// Work done by the most recent render() call
+struct RenderStats {
+    uint32_t bytesSent = 0;      // Bytes pushed over SPI through the Renderer
+    uint16_t dirtyRects = 0;     // Rectangles cleared (bands pushed in Strips mode)
+    uint16_t objectsDrawn = 0;   // Game objects redrawn
+    uint16_t tilesDrawn = 0;     // TileMap tiles sent
+};
+
+// Work done by the most recent checkCollisions() pass
+struct CollisionStats {
+    uint16_t objects = 0;          // Active objects and entities in the broadphase
+    uint32_t cellPairs = 0;        // Pairs sharing a grid cell, with duplicates
+    uint32_t candidatePairs = 0;   // Distinct pairs sent to narrowphase
+    uint32_t collisions = 0;       // onCollision() calls
+
+    // Pairs a brute-force pass would have tested
+    uint32_t bruteForcePairs() const { return (uint32_t)objects * (objects - 1) / 2; }
+};
+
+// Loop timing measured by Game::run()
+struct FrameTiming {
+    float fps = 0.0f;               // Frames rendered per second, over the last second
+    uint32_t lastFrameUs = 0;       // Start-to-start time of the last frame
+    uint32_t worstFrameUs = 0;      // Longest frame since the last reset
+    uint32_t lastWorkUs = 0;        // Update + render time of the last frame
+    uint32_t missedDeadlines = 0;   // Frames whose work overran the frame period
+    uint32_t droppedSteps = 0;      // Fixed steps skipped by the catch-up cap
+    uint8_t lastUpdateSteps = 0;    // Fixed steps run in the last frame
+};
 
 class Game {
 protected:
     Screen& screen;
-    std::vector<std::unique_ptr<GameObject>> gameObjects;
+    Renderer renderer;
+    std::vector<std::unique_ptr<ObjectPoolBase>> pools;  // Outlives gameObjects
+    std::vector<GameObjectPtr> gameObjects;
+    HandleTable objectHandles;  // GameObject id -> index in gameObjects
+    // Removals requested during checkCollisions(), applied after the pass
+    std::vector<uint32_t> pendingRemovals;
+    bool collisionPass = false;
+    std::unique_ptr<EntityWorld> entities;
     bool running;
     float deltaTime;
+    Scalar stepDelta;  // deltaTime converted once when the step is set
     uint32_t frameCount;
+    RenderMode renderMode;
+    uint16_t backgroundColor;
+    DirtyRegion dirtyRegion;
+    RenderStats renderStats;
+    display_dma_fence_t frameFence;
+    std::unique_ptr<StripCompositor> compositor;
+    std::unique_ptr<RenderCore> renderCore;
+    CoreUsage core0Usage;
+    CoreUsage core1Baseline;
+    uint32_t renderWaitUs;  // Time render() spent blocked on the display this frame
+    SpatialHash collisionGrid;
+    CollisionStats collisionStats;
+    uint32_t framePeriodUs;
+    uint32_t stepUs;
+    uint8_t maxCatchUpSteps;
+    FrameTiming frameTiming;
+    uint64_t fpsWindowStart;
+    uint32_t fpsWindowFrames;
+    Profiler profiler;
+    bool profilerOverlay;
+    bool profilerOverlayDue = false;  // Set by render(), drawn by run()
+    uint16_t profilerDumpInterval;
+    bool scrolling;
+    int16_t scrollTop;
+    int16_t scrollHeight;
+    int16_t scrollY;       // World row at the top of the window
+    int16_t scrollShownY;  // scrollY the panel's scroll start shows
+    // Renderer views the world is drawn through this frame: offset from world
+    // to frame memory rows, and the frame memory rows each covers
+    uint8_t viewCount;
+    int16_t viewOffset[2];
+    Rect viewArea[2];
+    TileMap* tileMap;
 
 public:
     Game(Screen& scr);
     virtual ~Game() = default;
 
-    // Main game loop - call this in your main() function
+    // Main game loop - call this in your main() function.
+    // Physics runs on a fixed step: each frame, update() runs once per step
+    // of real time elapsed (measured with the hardware timer), then render()
+    // runs once and the loop sleeps until the next frame deadline.
     virtual void run();
 
     // Stop the game loop
@@ -30,6 +122,39 @@ public:
     // Get frame count since game started
     uint32_t getFrameCount() const;
 
+    // Frame rate to pace rendering at; also sets the fixed step to one frame
+    // (default 60)
+    void setTargetFps(uint16_t fps);
+
+    // Physics step in microseconds; deltaTime passed to updates is this step
+    void setFixedTimestep(uint32_t us);
+    uint32_t getFixedTimestep() const;
+
+    // Most update steps run in one frame when catching up after a slow one;
+    // time beyond that is dropped so a stall can't snowball (default 4)
+    void setMaxCatchUpSteps(uint8_t steps);
+
+    // FPS, frame times and deadline misses
+    const FrameTiming& getFrameTiming() const;
+    void resetFrameTiming();
+
+    // Per-phase timings of recent frames. Only recorded when built with
+    // PICO_GAME_PROFILE; otherwise the profiler is empty and costs nothing.
+    Profiler& getProfiler();
+
+    // Draw FPS and per-phase avg/p99 in the top-right corner. The overlay is
+    // drawn straight to the panel over the game, after each frame that
+    // repaints it and every PROFILER_OVERLAY_REFRESH frames. Drawing it waits
+    // for core1 and the DMA queue to finish the frame; that wait and the
+    // drawing are reported as the Overlay phase, outside Frame, but they do
+    // remove the frame's overlap with the next update while it is shown.
+    // While scrolling it is only shown if it fits above the window.
+    static constexpr uint16_t PROFILER_OVERLAY_REFRESH = 30;
+    void setProfilerOverlay(bool enabled);
+
+    // Print profiler stats over stdio (USB serial) every `frames` frames; 0 to stop
+    void setProfilerDump(uint16_t frames);
+
 private:
     // Update all game objects and handle logic
     void update();
@@ -37,9 +162,52 @@ private:
     // Render all game objects
     void render();
 
-    // Check collisions between all active objects
+    // Check collisions between active objects; a spatial hash limits the
+    // box tests to objects sharing a grid cell
     void checkCollisions();
 
+    // Render paths for each RenderMode
+    void renderFullClear();
+    void renderDirtyRects();
+    void renderStrips();
+
+    // Give an object its id and append it to the scene
+    void attachObject(GameObjectPtr obj);
+
+    // Swap-and-pop: the last object moves into the freed index
+    void removeAt(size_t index);
+
+    // Top-right area the profiler overlay covers
+    Rect getProfilerOverlayRect() const;
+
+    // Whether the frame just rendered painted over the overlay, or it is due
+    // its periodic refresh; checked before dirtyRegion is cleared
+    bool isProfilerOverlayDue() const;
+    void drawProfilerOverlay();
+
+    // Add old and new bounds of everything that moved, appeared or was hidden
+    void collectDirtyObjects();
+
+    // Draw one object and remember where it landed
+    void drawObject(GameObject& obj);
+
+    // Work out this frame's views from the scroll position and mark the rows
+    // the window moved onto dirty
+    void beginViews();
+
+    // Draw through view `index`, optionally clipped to a world area
+    void selectView(uint8_t index);
+    void selectView(uint8_t index, const Rect& area);
+
+    // Fill a world area with the background color (or the tile map) and
+    // call onRenderBackground() for it, through view `index`
+    void clearArea(const Rect& area, uint8_t index);
+
+    void renderUser();
+
+    // Schedule the area an object was last drawn at for clearing
+    void eraseObject(GameObject& obj);
+
 public:
     // Render a simple rectangular sprite
     void renderSprite(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color);
@@ -50,9 +218,14 @@ public:
     // Render a circle
     void renderCircle(uint16_t x, uint16_t y, uint16_t radius, uint16_t color);
 
-    // Render a circle (filled)
+    // Render a circle (filled), one fill per row span
     void renderFilledCircle(uint16_t centerX, uint16_t centerY, uint16_t radius, uint16_t color);
 
+    // Render a filled triangle or convex polygon, one fill per row span
+    void renderFilledTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                              int16_t x2, int16_t y2, uint16_t color);
+    void renderFilledPolygon(const Point* points, uint8_t count, uint16_t color);
+
     // Render a line
     void renderLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color);
 
@@ -64,10 +237,38 @@ public:
     void renderBitmapTransparent(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
                                  const uint16_t* pixelData, uint16_t transparentColor);
 
+    // Render big-endian RGB565 bytes (the asset layout), sent as-is with no
+    // per-pixel conversion
+    void renderBitmap(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+                      const uint8_t* wireData);
+
+    // Render a pre-swapped bitmap, skipping pixels its opacity mask clears
+    void renderBitmap(uint16_t x, uint16_t y, const MaskedBitmap& bitmap);
+
+    // Scene storage is a dense array. Removal moves the last object into the
+    // freed index, so indices (and the draw order of overlapping objects) are
+    // not stable across removals; hold on to getId() instead. Ids carry a
+    // generation, so an id of a removed object stops resolving.
+
     // Add a game object to the scene
     void addGameObject(std::unique_ptr<GameObject> obj);
 
-    // Find game object by ID
+    // Preallocate room for `capacity` objects of type T. spawn<T>() then
+    // constructs into the pool, and the slot is recycled once the object goes
+    // inactive and is removed; no heap traffic after this call.
+    template <typename T>
+    void reservePool(uint16_t capacity);
+
+    // Construct a T and add it to the scene. Uses T's pool if one was
+    // reserved (nullptr when it is full), otherwise allocates on the heap.
+    template <typename T, typename... Args>
+    T* spawn(Args&&... args);
+
+    // Capacity, occupancy and high-water mark of T's pool (zeros if none)
+    template <typename T>
+    PoolStats getPoolStats() const;
+
+    // Find game object by ID (O(1)); nullptr if it was removed
     GameObject* findGameObject(uint32_t id);
 
     // Get total number of active game objects
@@ -76,12 +277,107 @@ public:
     // Get game object at index
     GameObject* getGameObjectAt(size_t index);
 
-    // Remove game object at index
+    // Remove game object at index (O(1)). From onCollision() the object is
+    // deactivated at once and removed when the collision pass ends; from
+    // update() prefer setActive(false), as removal moves another object
+    // into the freed index.
     void removeGameObject(size_t index);
 
+    // Remove game object by ID (O(1)); false if it was already removed
+    bool removeGameObjectById(uint32_t id);
+
     // Remove all game objects
     void clearGameObjects();
 
+private:
+    template <typename T>
+    ObjectPool<T>* findPool() const;
+
+public:
+    // Choose between full-screen clears, dirty-rectangle redraws (default) and
+    // strip composition. Strips allocates two band buffers (~30 KB) while active.
+    void setRenderMode(RenderMode mode);
+    RenderMode getRenderMode() const;
+
+    // Color used to clear the screen and erase moved objects
+    void setBackgroundColor(uint16_t color);
+    uint16_t getBackgroundColor() const;
+
+    // Force an area to be cleared and redrawn next frame.
+    // Call this for anything drawn in onRender() that moves or disappears.
+    void invalidate(int16_t x, int16_t y, int16_t width, int16_t height);
+
+    // Force the whole screen to be cleared and redrawn next frame
+    void invalidateAll();
+
+    // Hardware-scrolled playfield (see Screen::setScrollArea). Screen rows
+    // [top, top + height) become a window onto a taller world: screen row
+    // top + k shows world row getScrollY() + k, and objects, entities and
+    // invalidate() use world coordinates. Moving the window re-points the
+    // panel's scroll start, so only the rows it uncovers are cleared and
+    // redrawn. Rows outside the window stay put; draw HUDs there from
+    // onRender(), which keeps screen coordinates. World rows must fit in
+    // int16_t. Not available with RenderMode::Strips or dual core; returns
+    // false if it can't be enabled.
+    bool enableScrolling(int16_t top, int16_t height);
+    void disableScrolling();
+    bool isScrolling() const;
+
+    // World row at the top of the window; the next render() scrolls to it
+    void setScrollY(int16_t y);
+    int16_t getScrollY() const;
+
+    // Part of the world on screen (the whole screen when not scrolling)
+    Rect getWorldView() const;
+
+    // Paint the background from a TileMap instead of the background color.
+    // Cleared areas are redrawn tile by tile (one window per tile), dirty
+    // rectangles snap to the tile grid so whole tiles go out, and tiles
+    // changed with TileMap::setTile() are redrawn along with whatever
+    // overlaps them. The map is streamed to follow the view. It is not
+    // owned; pass nullptr before destroying it.
+    void setTileMap(TileMap* map);
+    TileMap* getTileMap();
+
+    // Stats for the last rendered frame. With dual core, bytesSent is for the
+    // last frame core1 finished, usually the one before.
+    const RenderStats& getRenderStats() const;
+
+    // Opt-in structure-of-arrays entities alongside GameObjects (see
+    // EntityWorld). Allocates storage for `capacity` entities; update()
+    // integrates them, and they collide and render with the scene.
+    void enableEntities(uint16_t capacity);
+
+    // nullptr until enableEntities() is called
+    EntityWorld* getEntities();
+
+    // Broadphase stats for the last collision pass
+    const CollisionStats& getCollisionStats() const;
+
+    // Hand SPI work to core1: render() records draw calls into a command queue
+    // and returns while core1 replays them, so update() for the next frame
+    // overlaps the transfer. Core1 drives SPI without DMA. Not available in
+    // RenderMode::Strips; returns false if it can't be enabled.
+    // While enabled, call waitForDisplay() before touching the SPI bus
+    // (e.g. touch reads) outside of rendering. Not available while scrolling.
+    bool setDualCore(bool enabled);
+    bool isDualCore() const;
+
+    // Busy/idle time per core (0 = game loop, 1 = render core) since the last
+    // resetCoreUsage(). Core0 counts sleeping and waiting on the display as idle.
+    CoreUsage getCoreUsage(uint8_t core) const;
+    void resetCoreUsage();
+
+    // With DMA, render() returns while the frame is still being sent so the
+    // next update() overlaps it. Fence for the last rendered frame, and a
+    // blocking wait for it to reach the panel (and, with dual core, for core1
+    // to finish replaying).
+    display_dma_fence_t getFrameFence() const;
+    void waitForDisplay();
+
+    // Get the renderer game objects draw through
+    Renderer& getRenderer();
+
     // Get reference to screen
     Screen& getScreen();
     
@@ -96,12 +392,63 @@ public:
     // Called every frame - user game logic here
     virtual void onUpdate(float deltaTime) {}
 
-    // Called every frame for custom rendering (before game objects render)
+    // Called every frame for custom rendering (before game objects render).
+    // In RenderMode::Strips this runs once per redrawn band, clipped to it.
+    // While scrolling it runs after the playfield, in screen coordinates.
     virtual void onRender() {}
 
+    // Called for each area the engine clears, after filling it with the
+    // background color, with drawing clipped to it; draw scenery here.
+    // Area is in world coordinates.
+    virtual void onRenderBackground(const Rect& area) {}
+
     // Called when two game objects collide
     virtual void onCollision(GameObject& objA, GameObject& objB) {}
 
+    // Called when two entities collide, or an entity and a game object
+    virtual void onEntityCollision(uint32_t entityA, uint32_t entityB) {}
+    virtual void onEntityObjectCollision(uint32_t entity, GameObject& obj) {}
+
     // Called when game is shutting down
     virtual void onShutdown() {}
 };
+
+template <typename T>
+ObjectPool<T>* Game::findPool() const {
+    for (auto& pool : pools) {
+        if (pool->getKey() == ObjectPool<T>::key()) {
+            return static_cast<ObjectPool<T>*>(pool.get());
+        }
+    }
+    return nullptr;
+}
+
+template <typename T>
+void Game::reservePool(uint16_t capacity) {
+    static_assert(std::is_base_of_v<GameObject, T>, "Pooled types must derive from GameObject");
+    if (findPool<T>()) return;
+
+    pools.push_back(std::make_unique<ObjectPool<T>>(capacity));
+    gameObjects.reserve(gameObjects.capacity() + capacity);
+}
+
+template <typename T, typename... Args>
+T* Game::spawn(Args&&... args) {
+    static_assert(std::is_base_of_v<GameObject, T>, "spawn() creates GameObjects");
+
+    T* obj;
+    if (ObjectPool<T>* pool = findPool<T>()) {
+        obj = pool->create(std::forward<Args>(args)...);
+        if (!obj) return nullptr;
+    } else {
+        obj = new T(std::forward<Args>(args)...);
+    }
+    attachObject(GameObjectPtr(obj));
+    return obj;
+}
+
+template <typename T>
+PoolStats Game::getPoolStats() const {
+    ObjectPool<T>* pool = findPool<T>();
+    return pool ? pool->getStats() : PoolStats();
+}
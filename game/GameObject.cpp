@@ -1,4 +1,10 @@
 #include "GameObject.hpp"
+#include "ObjectPool.hpp"
 
-// Static member initialization
-uint32_t GameObject::nextId = 0;
+void GameObjectDeleter::operator()(GameObject* obj) const {
+    if (obj->pool) {
+        obj->pool->destroy(obj);
+    } else {
+        delete obj;
+    }
+}
@@ -1,9 +1,15 @@
 #pragma once
 
+#include <bit>
 #include <cstdint>
+#include <memory>
+#include <type_traits>
 #include "Vector.hpp"
 #include "BoxCollider.hpp"
-#include "displaylib_16/ili9341.hpp"
+#include "Rect.hpp"
+#include "Renderer.hpp"
+
+class ObjectPoolBase;
 
 class GameObject {
 protected:
@@ -16,14 +22,60 @@ protected:
     uint16_t color;
     uint32_t id;
 
-    static uint32_t nextId;
+private:
+    friend class Game;
+    friend struct GameObjectDeleter;
+    template <typename> friend class ObjectPool;
+
+    // Screen area covered the last time the engine drew this object
+    Rect drawnBounds;
+    bool drawn = false;
+
+    // Pool the object lives in, nullptr if heap allocated
+    ObjectPoolBase* pool = nullptr;
+
+    // Game's fixed step in both types, set before it updates objects so the
+    // default update() doesn't convert deltaTime once per object
+    static inline float stepSeconds = 0.0f;
+    static inline Scalar stepScalar = Scalar();
+
+    static Scalar toScalarStep(float deltaTime) {
+        if constexpr (std::is_same_v<Scalar, float>) {
+            return deltaTime;
+        } else {
+            // Compare bits; a float compare is itself a soft-float call
+            if (std::bit_cast<uint32_t>(deltaTime) == std::bit_cast<uint32_t>(stepSeconds)) {
+                return stepScalar;
+            }
+            return Scalar(deltaTime);
+        }
+    }
 
 public:
-    GameObject(const Vector2& pos = Vector2(0.0f, 0.0f),
-               const BoxCollider& col = BoxCollider(10.0f, 10.0f),
+    GameObject(const Vector2& pos = Vector2(0, 0),
+               const BoxCollider& col = BoxCollider(10, 10),
                uint16_t col_color = 0xFFFF)
-        : position(pos), velocity(0.0f, 0.0f), scale(1.0f, 1.0f), collider(col),
-          active(true), visible(true), color(col_color), id(nextId++) {}
+        : position(pos), velocity(0, 0), scale(1, 1), collider(col),
+          active(true), visible(true), color(col_color), id(0) {}
+
+    // Copies take the object's state but not the engine's bookkeeping: a
+    // copy starts undrawn, unpooled and without an id, and assigning keeps
+    // the target's own pool, id and drawn area
+    GameObject(const GameObject& other)
+        : position(other.position), velocity(other.velocity), scale(other.scale),
+          collider(other.collider), active(other.active), visible(other.visible),
+          color(other.color), id(0) {}
+
+    GameObject& operator=(const GameObject& other) {
+        position = other.position;
+        velocity = other.velocity;
+        scale = other.scale;
+        collider = other.collider;
+        active = other.active;
+        visible = other.visible;
+        color = other.color;
+        return *this;
+    }
 
     virtual ~GameObject() = default;
 
@@ -37,11 +89,11 @@ public:
 
     // Update method - called every frame, user should override
     virtual void update(float deltaTime) {
-        position = position + (velocity * deltaTime);
+        position = position + (velocity * toScalarStep(deltaTime));
     }
 
     // Render method - called every frame, user should override
-    virtual void render(ILI9341_TFT& display) = 0;
+    virtual void render(Renderer& renderer) = 0;
 
     // Getters
     Vector2 getPosition() const { return position; }
@@ -52,6 +104,7 @@ public:
     bool isActive() const { return active; }
     bool isVisible() const { return visible; }
     uint16_t getColor() const { return color; }
+    // Handle assigned when added to a Game (0 before); stale once removed
     uint32_t getId() const { return id; }
 
     // Setters
@@ -81,8 +134,20 @@ public:
         return collider.intersects(position, other.collider, other.position);
     }
 
+    // Pixel rectangle covered by the collider, used by the collision broadphase
+    Rect getScreenBounds() const {
+        Vector2 min, max;
+        collider.getBounds(position, min, max);
+        return Rect::fromBounds(min, max);
+    }
+
+    // Pixel rectangle render() draws into; dirty-rect and strip redraws erase
+    // and repaint this area. Defaults to the collider bounds; override it if
+    // render() draws outside them, or the object leaves trails.
+    virtual Rect getRenderBounds() const { return getScreenBounds(); }
+
     // Get distance to another game object
-    float distanceTo(const GameObject& other) const {
+    Scalar distanceTo(const GameObject& other) const {
         return position.distance(other.position);
     }
 
@@ -92,3 +157,9 @@ public:
     }
 };
 
+// Returns pooled objects to their pool and deletes heap-allocated ones
+struct GameObjectDeleter {
+    void operator()(GameObject* obj) const;
+};
+
+using GameObjectPtr = std::unique_ptr<GameObject, GameObjectDeleter>;
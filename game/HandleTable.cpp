@@ -0,0 +1,41 @@
+#include "HandleTable.hpp"
+
+uint32_t HandleTable::allocate(uint16_t index) {
+    uint16_t slot;
+    if (freeHead_ != NO_SLOT) {
+        slot = freeHead_;
+        freeHead_ = slots_[slot].index;
+    } else {
+        slot = slots_.size();
+        slots_.push_back(Slot{0, 1});
+    }
+
+    slots_[slot].index = index;
+    return ((uint32_t)slots_[slot].generation << 16) | slot;
+}
+
+void HandleTable::release(uint32_t handle) {
+    uint16_t slot = slotOf(handle);
+    if (slot >= slots_.size() || slots_[slot].generation != generationOf(handle)) return;
+
+    // Generation 0 is skipped so no handle is ever 0
+    uint16_t generation = slots_[slot].generation + 1;
+    slots_[slot].generation = generation ? generation : 1;
+    slots_[slot].index = freeHead_;
+    freeHead_ = slot;
+}
+
+void HandleTable::move(uint32_t handle, uint16_t index) {
+    uint16_t slot = slotOf(handle);
+    if (slot < slots_.size() && slots_[slot].generation == generationOf(handle)) {
+        slots_[slot].index = index;
+    }
+}
+
+bool HandleTable::lookup(uint32_t handle, uint16_t& index) const {
+    uint16_t slot = slotOf(handle);
+    if (slot >= slots_.size() || slots_[slot].generation != generationOf(handle)) return false;
+
+    index = slots_[slot].index;
+    return true;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Maps generation-tagged handles to indices in a dense array.
+//
+// A handle packs a slot number (low 16 bits) and that slot's generation
+// (high 16 bits). Releasing a slot bumps its generation, so handles to
+// removed entries stop resolving instead of aliasing whatever reuses the
+// slot. 0 is never a valid handle. All operations are O(1); the slot table
+// only grows when more entries are live at once than ever before.
+class HandleTable {
+public:
+    static constexpr uint32_t INVALID = 0;
+
+    // New handle for an entry stored at `index`
+    uint32_t allocate(uint16_t index);
+
+    // Invalidate a handle and recycle its slot
+    void release(uint32_t handle);
+
+    // The entry behind `handle` moved to `index`
+    void move(uint32_t handle, uint16_t index);
+
+    // Current index of a live handle; false if it is stale or invalid
+    bool lookup(uint32_t handle, uint16_t& index) const;
+
+    size_t getSlotCount() const { return slots_.size(); }
+
+private:
+    static constexpr uint16_t NO_SLOT = 0xFFFF;
+
+    struct Slot {
+        uint16_t index;       // Dense index while live, next free slot otherwise
+        uint16_t generation;
+    };
+
+    std::vector<Slot> slots_;
+    uint16_t freeHead_ = NO_SLOT;
+
+    static uint16_t slotOf(uint32_t handle) { return handle & 0xFFFF; }
+    static uint16_t generationOf(uint32_t handle) { return handle >> 16; }
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include "GameObject.hpp"
+
+// Occupancy of one object pool
+struct PoolStats {
+    uint16_t capacity = 0;
+    uint16_t inUse = 0;
+    uint16_t highWater = 0;      // Most slots ever in use at once
+    uint32_t failedSpawns = 0;   // create() calls refused because the pool was full
+};
+
+// Type-erased pool interface, so GameObjectDeleter can hand objects back
+class ObjectPoolBase {
+public:
+    explicit ObjectPoolBase(const void* key) : key_(key) {}
+    virtual ~ObjectPoolBase() = default;
+
+    // Destroy an object created by this pool and free its slot
+    virtual void destroy(GameObject* obj) = 0;
+
+    const void* getKey() const { return key_; }
+    const PoolStats& getStats() const { return stats_; }
+
+protected:
+    PoolStats stats_;
+
+private:
+    const void* key_;
+};
+
+// Fixed-capacity slab of T. All storage is allocated up front; create() and
+// destroy() are O(1) free-list operations with no heap traffic.
+template <typename T>
+class ObjectPool : public ObjectPoolBase {
+public:
+    // Identifies T without RTTI
+    static const void* key() {
+        static const char tag = 0;
+        return &tag;
+    }
+
+    explicit ObjectPool(uint16_t capacity)
+        : ObjectPoolBase(key()), slots_(new Slot[capacity]), freeHead_(0) {
+        stats_.capacity = capacity;
+        for (uint16_t i = 0; i < capacity; i++) {
+            slots_[i].next = i + 1;
+        }
+    }
+
+    ~ObjectPool() override = default;
+
+    // Construct a T in a free slot; nullptr if the pool is full
+    template <typename... Args>
+    T* create(Args&&... args) {
+        if (freeHead_ >= stats_.capacity) {
+            stats_.failedSpawns++;
+            return nullptr;
+        }
+
+        uint16_t index = freeHead_;
+        freeHead_ = slots_[index].next;
+
+        T* obj = new (slots_[index].storage) T(std::forward<Args>(args)...);
+        obj->pool = this;
+
+        stats_.inUse++;
+        if (stats_.inUse > stats_.highWater) {
+            stats_.highWater = stats_.inUse;
+        }
+        return obj;
+    }
+
+    void destroy(GameObject* obj) override {
+        T* typed = static_cast<T*>(obj);
+        uint16_t index = reinterpret_cast<Slot*>(typed) - slots_.get();
+        typed->~T();
+
+        slots_[index].next = freeHead_;
+        freeHead_ = index;
+        stats_.inUse--;
+    }
+
+private:
+    union Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+        uint16_t next;  // Next free slot while unused
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    uint16_t freeHead_;
+};
@@ -0,0 +1,92 @@
+#include "Profiler.hpp"
+
+#if PICO_GAME_PROFILE
+
+#include <stdio.h>
+#include <algorithm>
+#include "pico/stdlib.h"
+
+static const char* const PHASE_NAMES[] = {"UPD", "COL", "REN", "ONR", "SPI", "FRM", "OVL"};
+
+Profiler::Profiler() {
+    reset();
+}
+
+void Profiler::endFrame() {
+    for (uint8_t p = 0; p < PHASES; p++) {
+        history_[next_][p] = current_[p] > 0xFFFF ? 0xFFFF : current_[p];
+        current_[p] = 0;
+    }
+    next_ = (next_ + 1) % HISTORY;
+    if (frames_ < HISTORY) frames_++;
+}
+
+void Profiler::reset() {
+    for (uint8_t p = 0; p < PHASES; p++) {
+        current_[p] = 0;
+    }
+    next_ = 0;
+    frames_ = 0;
+}
+
+PhaseStats Profiler::getStats(ProfilePhase phase) const {
+    PhaseStats stats;
+    if (frames_ == 0) return stats;
+
+    uint16_t samples[HISTORY];
+    uint32_t total = 0;
+    for (uint16_t i = 0; i < frames_; i++) {
+        samples[i] = history_[i][(uint8_t)phase];
+        total += samples[i];
+    }
+
+    uint16_t p99 = (uint32_t)(frames_ - 1) * 99 / 100;
+    std::nth_element(samples, samples + p99, samples + frames_);
+
+    stats.p99Us = samples[p99];
+    stats.avgUs = total / frames_;
+    stats.minUs = *std::min_element(samples, samples + frames_);
+    stats.maxUs = *std::max_element(samples, samples + frames_);
+    return stats;
+}
+
+Rect Profiler::getOverlayRect(int16_t x, int16_t y) {
+    return Rect::fromSize(x, y, OVERLAY_COLUMNS * GLYPH_WIDTH, OVERLAY_LINES * GLYPH_HEIGHT);
+}
+
+void Profiler::drawOverlay(ILI9341_TFT& display, int16_t x, int16_t y, float fps) const {
+    // Fixed-width lines with an opaque background overwrite the previous text.
+    // Sized for the widest values; lines are cut to the overlay width after.
+    char line[48];
+    display.setTextColor(ILI9341_TFT::C_WHITE, ILI9341_TFT::C_BLACK);
+
+    snprintf(line, sizeof(line), "FPS %5u.%u     ", (unsigned)fps, (unsigned)(fps * 10) % 10);
+    line[OVERLAY_COLUMNS] = '\0';
+    display.setCursor(x, y);
+    display.print(line);
+
+    for (uint8_t p = 0; p < PHASES; p++) {
+        PhaseStats stats = getStats((ProfilePhase)p);
+        snprintf(line, sizeof(line), "%s %5lu %5lu ", PHASE_NAMES[p],
+                 (unsigned long)stats.avgUs, (unsigned long)stats.p99Us);
+        line[OVERLAY_COLUMNS] = '\0';
+        display.setCursor(x, y + (p + 1) * GLYPH_HEIGHT);
+        display.print(line);
+    }
+}
+
+void Profiler::dump() const {
+    printf("phase    min    avg    p99    max  (us, %u frames)\n", frames_);
+    for (uint8_t p = 0; p < PHASES; p++) {
+        PhaseStats stats = getStats((ProfilePhase)p);
+        printf("%-5s %6lu %6lu %6lu %6lu\n", PHASE_NAMES[p],
+               (unsigned long)stats.minUs, (unsigned long)stats.avgUs,
+               (unsigned long)stats.p99Us, (unsigned long)stats.maxUs);
+    }
+}
+
+const char* Profiler::getPhaseName(ProfilePhase phase) {
+    return PHASE_NAMES[(uint8_t)phase];
+}
+
+#endif
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include "Rect.hpp"
+#include "displaylib_16/ili9341.hpp"
+
+// Build with -DPICO_GAME_PROFILE=ON to compile the timers in. When off, the
+// PROFILE_* macros expand to nothing and Profiler keeps no state.
+#ifndef PICO_GAME_PROFILE
+#define PICO_GAME_PROFILE 0
+#endif
+
+// Parts of a frame the engine times. Phases nest: Update includes
+// Collisions, Render includes OnRender and DisplayWait.
+enum class ProfilePhase : uint8_t {
+    Update,       // All fixed steps of Game::update()
+    Collisions,   // Game::checkCollisions()
+    Render,       // Game::render()
+    OnRender,     // User onRender() callbacks
+    DisplayWait,  // Blocked on the previous frame's SPI/DMA or core1
+    Frame,        // Update + render, excluding the frame pacing sleep
+    Overlay,      // Drawing the profiler overlay, including the display drain
+    Count
+};
+
+// Per-phase microseconds over the recorded frames
+struct PhaseStats {
+    uint32_t minUs = 0;
+    uint32_t avgUs = 0;
+    uint32_t p99Us = 0;
+    uint32_t maxUs = 0;
+};
+
+#if PICO_GAME_PROFILE
+
+#include "pico/stdlib.h"
+
+// Per-phase timings of the last HISTORY frames.
+//
+// Phase times accumulate into the current frame (a phase may run several
+// times, like Update when catching up) and endFrame() commits them to a ring.
+// Timing is a read of the 32-bit hardware timer on each side of a phase.
+class Profiler {
+public:
+    static constexpr uint16_t HISTORY = 128;
+    static constexpr uint8_t PHASES = (uint8_t)ProfilePhase::Count;
+
+    // Overlay text cell and size
+    static constexpr int16_t GLYPH_WIDTH = 6;
+    static constexpr int16_t GLYPH_HEIGHT = 8;
+    static constexpr int16_t OVERLAY_COLUMNS = 16;
+    static constexpr int16_t OVERLAY_LINES = PHASES + 1;
+
+    Profiler();
+
+    void add(ProfilePhase phase, uint32_t us) { current_[(uint8_t)phase] += us; }
+
+    // Commit the current frame to the history
+    void endFrame();
+
+    void reset();
+
+    uint16_t getFrameCount() const { return frames_; }
+    PhaseStats getStats(ProfilePhase phase) const;
+
+    // Screen area drawOverlay() covers when drawn at (x, y)
+    static Rect getOverlayRect(int16_t x, int16_t y);
+
+    // Draw FPS plus avg/p99 per phase with the display's text routines
+    void drawOverlay(ILI9341_TFT& display, int16_t x, int16_t y, float fps) const;
+
+    // Print min/avg/p99/max per phase to stdio (USB serial)
+    void dump() const;
+
+    static const char* getPhaseName(ProfilePhase phase);
+
+private:
+    uint16_t history_[HISTORY][PHASES];  // Saturates at ~65 ms
+    uint32_t current_[PHASES];
+    uint16_t next_;
+    uint16_t frames_;
+};
+
+// Adds the lifetime of the scope to a phase
+class ProfileScope {
+public:
+    ProfileScope(Profiler& profiler, ProfilePhase phase)
+        : profiler_(profiler), phase_(phase), start_(time_us_32()) {}
+
+    ~ProfileScope() { profiler_.add(phase_, time_us_32() - start_); }
+
+private:
+    Profiler& profiler_;
+    ProfilePhase phase_;
+    uint32_t start_;
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(profiler, phase) \
+    ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)((profiler), (phase))
+#define PROFILE_ADD(profiler, phase, us) (profiler).add((phase), (us))
+#define PROFILE_END_FRAME(profiler) (profiler).endFrame()
+
+#else
+
+// Compiled-out profiler: same interface, no storage, no work
+class Profiler {
+public:
+    static constexpr uint16_t HISTORY = 0;
+
+    void add(ProfilePhase, uint32_t) {}
+    void endFrame() {}
+    void reset() {}
+    uint16_t getFrameCount() const { return 0; }
+    PhaseStats getStats(ProfilePhase) const { return PhaseStats(); }
+    static Rect getOverlayRect(int16_t, int16_t) { return Rect(); }
+    void drawOverlay(ILI9341_TFT&, int16_t, int16_t, float) const {}
+    void dump() const {}
+    static const char* getPhaseName(ProfilePhase) { return ""; }
+};
+
+#define PROFILE_SCOPE(profiler, phase) do {} while (0)
+#define PROFILE_ADD(profiler, phase, us) do {} while (0)
+#define PROFILE_END_FRAME(profiler) do {} while (0)
+
+#endif
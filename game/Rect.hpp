@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include "Vector.hpp"
+
+// Integer screen position, e.g. a polygon vertex
+struct Point {
+    int16_t x, y;
+};
+
+// Integer screen rectangle, half-open: covers [x0, x1) x [y0, y1)
+struct Rect {
+    int16_t x0, y0, x1, y1;
+
+    Rect(int16_t left = 0, int16_t top = 0, int16_t right = 0, int16_t bottom = 0)
+        : x0(left), y0(top), x1(right), y1(bottom) {}
+
+    static Rect fromSize(int16_t x, int16_t y, int16_t w, int16_t h) {
+        return Rect(x, y, x + w, y + h);
+    }
+
+    // Smallest pixel rectangle covering a float min/max box
+    template <typename T>
+    static Rect fromBounds(const Vector2T<T>& min, const Vector2T<T>& max) {
+        return Rect((int16_t)floorToInt(min.x), (int16_t)floorToInt(min.y),
+                    (int16_t)ceilToInt(max.x), (int16_t)ceilToInt(max.y));
+    }
+
+    int16_t width() const { return x1 - x0; }
+    int16_t height() const { return y1 - y0; }
+    int32_t area() const { return isEmpty() ? 0 : (int32_t)width() * height(); }
+    bool isEmpty() const { return x1 <= x0 || y1 <= y0; }
+
+    bool intersects(const Rect& other) const {
+        return x0 < other.x1 && other.x0 < x1 && y0 < other.y1 && other.y0 < y1;
+    }
+
+    bool contains(const Rect& other) const {
+        return other.x0 >= x0 && other.x1 <= x1 && other.y0 >= y0 && other.y1 <= y1;
+    }
+
+    // Bounding box of both rectangles
+    Rect united(const Rect& other) const {
+        return Rect(x0 < other.x0 ? x0 : other.x0, y0 < other.y0 ? y0 : other.y0,
+                    x1 > other.x1 ? x1 : other.x1, y1 > other.y1 ? y1 : other.y1);
+    }
+
+    // Overlapping part of both rectangles (may be empty)
+    Rect clipped(const Rect& other) const {
+        return Rect(x0 > other.x0 ? x0 : other.x0, y0 > other.y0 ? y0 : other.y0,
+                    x1 < other.x1 ? x1 : other.x1, y1 < other.y1 ? y1 : other.y1);
+    }
+
+    bool operator==(const Rect& other) const {
+        return x0 == other.x0 && y0 == other.y0 && x1 == other.x1 && y1 == other.y1;
+    }
+
+    bool operator!=(const Rect& other) const {
+        return !(*this == other);
+    }
+};
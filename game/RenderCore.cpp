@@ -0,0 +1,141 @@
+#include "RenderCore.hpp"
+#include "pico/multicore.h"
+
+RenderCore* RenderCore::active_ = nullptr;
+
+RenderCore::RenderCore(ILI9341_TFT& display, int16_t width, int16_t height)
+    : renderer_(display, width, height), running_(false), stopRequested_(false),
+      framesSubmitted_(0), framesCompleted_(0), busyUs_(0), idleUs_(0), lastFrameBytes_(0),
+      viewX_(0), viewY_(0) {}
+
+RenderCore::~RenderCore() {
+    stop();
+}
+
+void RenderCore::start() {
+    if (running_ || active_) return;
+
+    active_ = this;
+    running_ = true;
+    stopRequested_.store(false, std::memory_order_relaxed);
+    multicore_launch_core1(core1Entry);
+}
+
+void RenderCore::stop() {
+    if (!running_) return;
+
+    waitIdle();
+    // Let core1 leave its loop so a host thread can be joined; on the
+    // device the reset stops it either way
+    stopRequested_.store(true, std::memory_order_release);
+    multicore_reset_core1();
+    running_ = false;
+    active_ = nullptr;
+}
+
+void RenderCore::endFrame() {
+    queue_.push(DrawCommand{DrawCommand::Op::EndFrame, 0, 0, 0, 0, 0, nullptr});
+    framesSubmitted_++;
+}
+
+void RenderCore::waitForFrames(uint32_t maxInFlight) {
+    while (framesSubmitted_ - getFramesCompleted() > maxInFlight) {
+        tight_loop_contents();
+    }
+}
+
+CoreUsage RenderCore::getUsage() const {
+    CoreUsage usage;
+    usage.busyUs = busyUs_.load(std::memory_order_relaxed);
+    usage.idleUs = idleUs_.load(std::memory_order_relaxed);
+    return usage;
+}
+
+void RenderCore::core1Entry() {
+    active_->core1Loop();
+}
+
+void RenderCore::core1Loop() {
+    DrawCommand cmd;
+    bool busy = false;
+    uint32_t mark = time_us_32();
+
+    // Only sample the timer on busy/idle transitions, not per command
+    while (!stopRequested_.load(std::memory_order_acquire)) {
+        if (queue_.tryPop(cmd)) {
+            if (!busy) {
+                uint32_t now = time_us_32();
+                idleUs_.store(idleUs_.load(std::memory_order_relaxed) + (now - mark),
+                              std::memory_order_relaxed);
+                mark = now;
+                busy = true;
+            }
+            execute(cmd);
+        } else {
+            if (busy) {
+                uint32_t now = time_us_32();
+                busyUs_.store(busyUs_.load(std::memory_order_relaxed) + (now - mark),
+                              std::memory_order_relaxed);
+                mark = now;
+                busy = false;
+            }
+            tight_loop_contents();
+        }
+    }
+}
+
+void RenderCore::execute(const DrawCommand& cmd) {
+    switch (cmd.op) {
+        case DrawCommand::Op::FillRect:
+            renderer_.fillRect(cmd.x, cmd.y, cmd.w, cmd.h, cmd.color);
+            break;
+        case DrawCommand::Op::Pixel:
+            renderer_.drawPixel(cmd.x, cmd.y, cmd.color);
+            break;
+        case DrawCommand::Op::Line:
+            renderer_.drawLine(cmd.x, cmd.y, cmd.w, cmd.h, cmd.color);
+            break;
+        case DrawCommand::Op::Circle:
+            renderer_.drawCircle(cmd.x, cmd.y, cmd.w, cmd.color);
+            break;
+        case DrawCommand::Op::FillCircle:
+            renderer_.fillCircle(cmd.x, cmd.y, cmd.w, cmd.color);
+            break;
+        case DrawCommand::Op::Blit:
+            renderer_.blit(cmd.x, cmd.y, cmd.w, cmd.h, static_cast<const uint8_t*>(cmd.data));
+            break;
+        case DrawCommand::Op::BlitTransparent:
+            renderer_.blitTransparent(cmd.x, cmd.y, cmd.w, cmd.h,
+                                      static_cast<const uint8_t*>(cmd.data), cmd.color);
+            break;
+        case DrawCommand::Op::Blit16:
+            renderer_.blit16(cmd.x, cmd.y, cmd.w, cmd.h, static_cast<const uint16_t*>(cmd.data));
+            break;
+        case DrawCommand::Op::Blit16Transparent:
+            renderer_.blit16Transparent(cmd.x, cmd.y, cmd.w, cmd.h,
+                                        static_cast<const uint16_t*>(cmd.data), cmd.color);
+            break;
+        case DrawCommand::Op::BlitIndexed:
+            renderer_.blitIndexed(cmd.x, cmd.y, *static_cast<const IndexedBitmap*>(cmd.data));
+            break;
+        case DrawCommand::Op::BlitRle:
+            renderer_.blitRle(cmd.x, cmd.y, *static_cast<const RleBitmap*>(cmd.data));
+            break;
+        case DrawCommand::Op::BlitMasked:
+            renderer_.blitMasked(cmd.x, cmd.y, *static_cast<const MaskedBitmap*>(cmd.data));
+            break;
+        case DrawCommand::Op::Origin:
+            viewX_ = cmd.x;
+            viewY_ = cmd.y;
+            break;
+        case DrawCommand::Op::Clip:
+            renderer_.setView(viewX_, viewY_, Rect::fromSize(cmd.x, cmd.y, cmd.w, cmd.h));
+            break;
+        case DrawCommand::Op::EndFrame:
+            lastFrameBytes_.store(renderer_.getBytesSent(), std::memory_order_relaxed);
+            renderer_.resetStats();
+            framesCompleted_.store(framesCompleted_.load(std::memory_order_relaxed) + 1,
+                                   std::memory_order_release);
+            break;
+    }
+}
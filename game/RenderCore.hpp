@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "Renderer.hpp"
+#include "DrawCommand.hpp"
+
+// Busy vs. idle time of one core, in microseconds
+struct CoreUsage {
+    uint32_t busyUs = 0;
+    uint32_t idleUs = 0;
+
+    // Fraction of time spent working, 0.0 - 1.0
+    float utilization() const {
+        uint32_t total = busyUs + idleUs;
+        return total ? (float)busyUs / (float)total : 0.0f;
+    }
+};
+
+// Drives the display from core1.
+//
+// Core0 records draw calls into the command queue (Renderer::setRecorder) and
+// closes each frame with endFrame(); core1 drains the queue and replays it
+// through its own Renderer, so game logic never touches SPI. The queue
+// streams, so core1 starts on a frame while core0 is still recording it.
+//
+// Core1 drives SPI with blocking writes: the DMA queue's completion interrupt
+// belongs to core0. Touch reads and raw display access share the bus, so
+// call waitIdle() first.
+class RenderCore {
+public:
+    RenderCore(ILI9341_TFT& display, int16_t width, int16_t height);
+    ~RenderCore();
+
+    // Launch / reset core1
+    void start();
+    void stop();
+    bool isRunning() const { return running_; }
+
+    DrawCommandQueue& getQueue() { return queue_; }
+
+    // Core0: close the frame being recorded
+    void endFrame();
+
+    // Core0: block until at most `maxInFlight` submitted frames are unfinished
+    void waitForFrames(uint32_t maxInFlight);
+
+    // Core0: block until every submitted frame is on the panel
+    void waitIdle() { waitForFrames(0); }
+
+    uint32_t getFramesSubmitted() const { return framesSubmitted_; }
+    uint32_t getFramesCompleted() const { return framesCompleted_.load(std::memory_order_acquire); }
+
+    // Core1 time spent replaying vs. waiting for commands
+    CoreUsage getUsage() const;
+
+    // SPI traffic of the last frame core1 finished
+    uint32_t getLastFrameBytes() const { return lastFrameBytes_.load(std::memory_order_relaxed); }
+
+private:
+    static RenderCore* active_;
+    static void core1Entry();
+
+    void core1Loop();
+    void execute(const DrawCommand& cmd);
+
+    Renderer renderer_;
+    DrawCommandQueue queue_;
+    bool running_;
+    std::atomic<bool> stopRequested_;
+    uint32_t framesSubmitted_;
+    std::atomic<uint32_t> framesCompleted_;
+    std::atomic<uint32_t> busyUs_;
+    std::atomic<uint32_t> idleUs_;
+    std::atomic<uint32_t> lastFrameBytes_;
+    int16_t viewX_;  // Offset from the last Origin command, applied by Clip
+    int16_t viewY_;
+};
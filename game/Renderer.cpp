@@ -0,0 +1,823 @@
+#include "Renderer.hpp"
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+// First column at or after `col` (bitmap coordinates, before `end`) whose
+// mask bit differs from `opaque`; whole bytes of the same state are skipped
+int16_t scanMask(const uint8_t* mask, int16_t col, int16_t end, bool opaque) {
+    const uint8_t uniform = opaque ? 0xFF : 0x00;
+    while (col < end) {
+        if ((col & 7) == 0 && end - col >= 8 && mask[col >> 3] == uniform) {
+            col += 8;
+            continue;
+        }
+        if (((mask[col >> 3] & (0x80 >> (col & 7))) != 0) != opaque) break;
+        col++;
+    }
+    return col;
+}
+
+// Cohen-Sutherland outcode of a point against an inclusive box
+enum : uint8_t { LEFT = 1, RIGHT = 2, ABOVE = 4, BELOW = 8 };
+
+uint8_t outcode(int16_t x, int16_t y, const Rect& clip) {
+    uint8_t code = 0;
+    if (x < clip.x0) code |= LEFT;
+    else if (x >= clip.x1) code |= RIGHT;
+    if (y < clip.y0) code |= ABOVE;
+    else if (y >= clip.y1) code |= BELOW;
+    return code;
+}
+
+// Narrow [first, last] to the steps of a line walk whose coordinate lies in
+// [lo, hi]. At step i the coordinate is start + sign * t(i), with
+// t(i) = floor((2 * i * num + den) / (2 * den)); num == den for the major axis.
+void clampSteps(int32_t start, int32_t sign, int32_t num, int32_t den,
+                int32_t lo, int32_t hi, int32_t& first, int32_t& last) {
+    int64_t tlo = sign > 0 ? lo - start : start - hi;
+    int64_t thi = sign > 0 ? hi - start : start - lo;
+    if (thi < 0) {
+        last = -1;
+        return;
+    }
+    if (tlo > 0) {
+        int64_t minStep = (2 * tlo * den - den + 2 * num - 1) / (2 * num);
+        if (minStep > first) first = (int32_t)minStep;
+    }
+    int64_t maxStep = (2 * (thi + 1) * den - den - 1) / (2 * num);
+    if (maxStep < last) last = (int32_t)maxStep;
+}
+
+}
+
+Renderer::Renderer(ILI9341_TFT& display, int16_t width, int16_t height)
+    : display_(display), bounds_(0, 0, width, height), clip_(bounds_), bandArea_(bounds_),
+      viewArea_(bounds_), originX_(0), originY_(0), band_(nullptr),
+      recorder_(nullptr), dmaEnabled_(false),
+      bytesSent_(0), windowCount_(0), swapUsed_(0), swapFence_(0) {}
+
+void Renderer::setDmaEnabled(bool enabled) {
+    waitIdle();
+    dmaEnabled_ = enabled && display_dma_is_ready();
+}
+
+void Renderer::setBand(uint16_t* pixels, const Rect& area) {
+    band_ = pixels;
+    bandArea_ = pixels ? area.clipped(bounds_) : bounds_;
+    clip_ = bandArea_.clipped(viewArea_);
+}
+
+void Renderer::setView(int16_t dx, int16_t dy, const Rect& area) {
+    if (recorder_) {
+        record(DrawCommand::Op::Origin, dx, dy, 0, 0, 0);
+        record(DrawCommand::Op::Clip, area.x0, area.y0, area.width(), area.height(), 0);
+        return;
+    }
+
+    originX_ = dx;
+    originY_ = dy;
+    viewArea_ = area.clipped(bounds_);
+    clip_ = bandArea_.clipped(viewArea_);
+}
+
+void Renderer::resetView() {
+    setView(0, 0, bounds_);
+}
+
+display_dma_fence_t Renderer::fence() const {
+    return dmaEnabled_ ? display_dma_fence() : 0;
+}
+
+void Renderer::wait(display_dma_fence_t fence) const {
+    if (dmaEnabled_) {
+        display_dma_wait(fence);
+    }
+}
+
+void Renderer::waitIdle() const {
+    if (dmaEnabled_) {
+        display_dma_wait_idle();
+    }
+}
+
+void Renderer::resetStats() {
+    bytesSent_ = 0;
+    windowCount_ = 0;
+}
+
+void Renderer::countWindow(uint32_t pixels) {
+    bytesSent_ += WINDOW_SETUP_BYTES + pixels * 2;
+    windowCount_++;
+}
+
+void Renderer::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (recorder_) {
+        record(DrawCommand::Op::FillRect, x, y, w, h, color);
+        return;
+    }
+
+    x += originX_;
+    y += originY_;
+
+    Rect r = Rect::fromSize(x, y, w, h).clipped(clip_);
+    if (r.isEmpty()) return;
+
+    fillArea(r, color);
+}
+
+void Renderer::fillArea(const Rect& r, uint16_t color) {
+    if (band_) {
+        uint16_t wire = toWire(color);
+        for (int16_t py = r.y0; py < r.y1; py++) {
+            uint16_t* row = bandRow(py);
+            for (int16_t px = r.x0; px < r.x1; px++) {
+                row[px] = wire;
+            }
+        }
+        return;
+    }
+
+    if (dmaEnabled_) {
+        display_dma_fill_rect(r.x0, r.y0, r.width(), r.height(), color);
+    } else {
+        display_.fillRect(r.x0, r.y0, r.width(), r.height(), color);
+    }
+    countWindow(r.area());
+}
+
+void Renderer::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (recorder_) {
+        record(DrawCommand::Op::Pixel, x, y, 1, 1, color);
+        return;
+    }
+
+    x += originX_;
+    y += originY_;
+
+    if (x < clip_.x0 || x >= clip_.x1 || y < clip_.y0 || y >= clip_.y1) return;
+
+    if (band_) {
+        bandRow(y)[x] = toWire(color);
+        return;
+    }
+
+    if (dmaEnabled_) {
+        display_dma_fill_rect(x, y, 1, 1, color);
+    } else {
+        display_.drawPixel(x, y, color);
+    }
+    countWindow(1);
+}
+
+void Renderer::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    if (recorder_) {
+        record(DrawCommand::Op::Line, x0, y0, x1, y1, color);
+        return;
+    }
+
+    x0 += originX_;
+    y0 += originY_;
+    x1 += originX_;
+    y1 += originY_;
+
+    // Horizontal and vertical lines are a single window
+    if (x0 == x1 || y0 == y1) {
+        Rect r(x0 < x1 ? x0 : x1, y0 < y1 ? y0 : y1,
+               (x0 < x1 ? x1 : x0) + 1, (y0 < y1 ? y1 : y0) + 1);
+        r = r.clipped(clip_);
+        if (!r.isEmpty()) fillArea(r, color);
+        return;
+    }
+
+    uint8_t code0 = outcode(x0, y0, clip_);
+    uint8_t code1 = outcode(x1, y1, clip_);
+    if (code0 & code1) return;
+
+    // Walk the major axis; the minor axis advances by minor/major per step,
+    // rounded to nearest. Pixels on the same minor coordinate form a run
+    // that goes out as one fill window.
+    const bool steep = std::abs(y1 - y0) > std::abs(x1 - x0);
+    const int32_t majorStart = steep ? y0 : x0;
+    const int32_t minorStart = steep ? x0 : y0;
+    const int32_t majorSign = (steep ? y1 > y0 : x1 > x0) ? 1 : -1;
+    const int32_t minorSign = (steep ? x1 > x0 : y1 > y0) ? 1 : -1;
+    const int32_t major = std::abs(steep ? y1 - y0 : x1 - x0);
+    const int32_t minor = std::abs(steep ? x1 - x0 : y1 - y0);
+
+    int32_t first = 0;
+    int32_t last = major;
+    if (code0 | code1) {
+        // Clip the step range rather than the end points, so the visible
+        // pixels are the same whatever the clip (strips and views included)
+        const Rect& c = clip_;
+        clampSteps(majorStart, majorSign, major, major,
+                   steep ? c.y0 : c.x0, (steep ? c.y1 : c.x1) - 1, first, last);
+        clampSteps(minorStart, minorSign, minor, major,
+                   steep ? c.x0 : c.y0, (steep ? c.x1 : c.y1) - 1, first, last);
+        if (first > last) return;
+    }
+
+    const int32_t twoMajor = 2 * major;
+    const int64_t numerator = 2 * (int64_t)first * minor + major;
+    int32_t t = (int32_t)(numerator / twoMajor);
+    int32_t rem = (int32_t)(numerator % twoMajor);
+    int32_t runStart = first;
+
+    for (int32_t i = first; i <= last; i++) {
+        int32_t nextT = t;
+        rem += 2 * minor;
+        if (rem >= twoMajor) {
+            rem -= twoMajor;
+            nextT++;
+        }
+        if (nextT == t && i < last) continue;
+
+        // Steps runStart..i share minor coordinate t
+        int16_t a = (int16_t)(majorStart + majorSign * runStart);
+        int16_t b = (int16_t)(majorStart + majorSign * i);
+        int16_t lo = a < b ? a : b;
+        int16_t hi = a < b ? b : a;
+        int16_t m = (int16_t)(minorStart + minorSign * t);
+        fillArea(steep ? Rect(m, lo, m + 1, hi + 1) : Rect(lo, m, hi + 1, m + 1), color);
+
+        runStart = i + 1;
+        t = nextT;
+    }
+}
+
+void Renderer::drawCircle(int16_t cx, int16_t cy, int16_t radius, uint16_t color) {
+    if (radius < 0) return;
+    if (recorder_) {
+        record(DrawCommand::Op::Circle, cx, cy, radius, 0, color);
+        return;
+    }
+
+    // Midpoint circle. Steps that keep dy form a horizontal run in the
+    // octants near the poles and a vertical run in the ones near the
+    // equator; each run is mirrored into four fills.
+    int16_t dx = 0;
+    int16_t dy = radius;
+    int16_t d = 1 - radius;
+    int16_t runStart = 0;
+
+    while (true) {
+        int16_t runDx = dx;
+        int16_t runDy = dy;
+        dx++;
+        if (d < 0) {
+            d += 2 * dx + 1;
+        } else {
+            dy--;
+            d += 2 * (dx - dy) + 1;
+        }
+
+        bool done = dx > dy;
+        if (dy != runDy || done) {
+            int16_t len = runDx - runStart + 1;
+            fillRect(cx + runStart, cy + runDy, len, 1, color);
+            fillRect(cx - runDx, cy + runDy, len, 1, color);
+            fillRect(cx + runStart, cy - runDy, len, 1, color);
+            fillRect(cx - runDx, cy - runDy, len, 1, color);
+            fillRect(cx + runDy, cy + runStart, 1, len, color);
+            fillRect(cx - runDy, cy + runStart, 1, len, color);
+            fillRect(cx + runDy, cy - runDx, 1, len, color);
+            fillRect(cx - runDy, cy - runDx, 1, len, color);
+            runStart = dx;
+        }
+        if (done) break;
+    }
+}
+
+void Renderer::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (w <= 0 || h <= 0) return;
+
+    // Each edge is a one-pixel-thick fill, i.e. a single window
+    fillRect(x, y, w, 1, color);
+    if (h > 1) fillRect(x, y + h - 1, w, 1, color);
+    if (h > 2) {
+        fillRect(x, y + 1, 1, h - 2, color);
+        if (w > 1) fillRect(x + w - 1, y + 1, 1, h - 2, color);
+    }
+}
+
+void Renderer::fillCircle(int16_t cx, int16_t cy, int16_t radius, uint16_t color) {
+    if (radius < 0) return;
+    if (recorder_) {
+        record(DrawCommand::Op::FillCircle, cx, cy, radius, 0, color);
+        return;
+    }
+
+    // Half-width of row dy is the largest w with w*w + dy*dy <= r*r. It only
+    // shrinks as dy grows, so track rem = r*r - dy*dy - w*w incrementally.
+    int32_t w = radius;
+    int32_t rem = 0;
+    int16_t groupStart = 0;
+    int32_t groupW = radius;
+
+    for (int16_t dy = 0; dy <= radius + 1; dy++) {
+        if (dy <= radius) {
+            while (rem < 0) {
+                rem += 2 * w - 1;
+                w--;
+            }
+            rem -= 2 * dy + 1;
+            if (w == groupW) continue;
+        }
+
+        // Rows groupStart..dy-1 above and below the center share one span
+        int16_t rows = dy - groupStart;
+        int16_t spanW = (int16_t)(groupW * 2 + 1);
+        if (groupStart == 0) {
+            fillRect(cx - groupW, cy - (rows - 1), spanW, rows * 2 - 1, color);
+        } else {
+            fillRect(cx - groupW, cy - (dy - 1), spanW, rows, color);
+            fillRect(cx - groupW, cy + groupStart, spanW, rows, color);
+        }
+        groupStart = dy;
+        groupW = w;
+    }
+}
+
+void Renderer::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                            int16_t x2, int16_t y2, uint16_t color) {
+    const Point points[3] = {{x0, y0}, {x1, y1}, {x2, y2}};
+    fillPolygon(points, 3, color);
+}
+
+void Renderer::fillPolygon(const Point* points, uint8_t count, uint16_t color) {
+    if (count < 3) return;
+
+    uint8_t top = 0;
+    int16_t bottomY = points[0].y;
+    for (uint8_t i = 1; i < count; i++) {
+        if (points[i].y < points[top].y) top = i;
+        if (points[i].y > bottomY) bottomY = points[i].y;
+    }
+
+    // Two edge walkers leave the top vertex in opposite directions and meet
+    // at the bottom; x is 16.16 fixed point at the current row's center
+    struct Edge {
+        uint8_t from;
+        int8_t step;
+        int16_t endY;
+        int32_t x;
+        int32_t dx;
+    };
+
+    auto advance = [&](Edge& e, int16_t y) {
+        // Move to the edge spanning row y, skipping horizontal ones
+        while (e.endY <= y) {
+            uint8_t to = (uint8_t)((e.from + e.step + count) % count);
+            const Point& a = points[e.from];
+            const Point& b = points[to];
+            e.from = to;
+            e.endY = b.y;
+            if (b.y <= a.y) continue;
+            e.dx = (int32_t)(((int64_t)(b.x - a.x) << 16) / (b.y - a.y));
+            e.x = ((int32_t)a.x << 16) + e.dx * (y - a.y) + e.dx / 2;
+        }
+    };
+
+    const int16_t topY = points[top].y;
+    Edge forward{top, 1, topY, 0, 0};
+    Edge backward{top, -1, topY, 0, 0};
+
+    // Consecutive rows with the same span, sent as one fill
+    int16_t blockX0 = 0;
+    int16_t blockX1 = 0;
+    int16_t blockY = topY;
+    int16_t blockRows = 0;
+    auto flushBlock = [&]() {
+        if (blockRows > 0 && blockX1 > blockX0) {
+            fillRect(blockX0, blockY, blockX1 - blockX0, blockRows, color);
+        }
+        blockRows = 0;
+    };
+
+    for (int16_t y = topY; y < bottomY; y++) {
+        advance(forward, y);
+        advance(backward, y);
+
+        int32_t left = forward.x < backward.x ? forward.x : backward.x;
+        int32_t right = forward.x < backward.x ? backward.x : forward.x;
+        // Pixels whose centers lie in [left, right)
+        int16_t x0 = (int16_t)((left + 0x7FFF) >> 16);
+        int16_t x1 = (int16_t)((right + 0x7FFF) >> 16);
+
+        if (x0 != blockX0 || x1 != blockX1) flushBlock();
+        if (blockRows == 0) {
+            blockX0 = x0;
+            blockX1 = x1;
+            blockY = y;
+        }
+        blockRows++;
+
+        forward.x += forward.dx;
+        backward.x += backward.dx;
+    }
+    flushBlock();
+}
+
+void Renderer::writeWindow(int16_t x, int16_t y, uint16_t w, uint16_t h,
+                           const uint8_t* data, uint32_t stride) {
+    if (stride == (uint32_t)w * 2) {
+        sendWindow(x, y, w, h, data);
+        return;
+    }
+
+    for (uint16_t row = 0; row < h; row++) {
+        sendWindow(x, y + row, w, 1, data + row * stride);
+    }
+}
+
+void Renderer::sendWindow(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t* data) {
+    if (dmaEnabled_) {
+        display_dma_blit(x, y, w, h, data);
+    } else {
+        // displaylib only reads from the buffer
+        display_.drawBitmap16Data(x, y, const_cast<uint8_t*>(data), w, h);
+    }
+    countWindow((uint32_t)w * h);
+}
+
+uint8_t* Renderer::stagePixels(uint16_t pixels) {
+    if (swapUsed_ + pixels > SWAP_BUFFER_PIXELS) {
+        wait(swapFence_);
+        swapUsed_ = 0;
+    }
+    uint8_t* out = swapBuffer_ + swapUsed_ * 2;
+    swapUsed_ += pixels;
+    return out;
+}
+
+void Renderer::blit(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t* data) {
+    if (recorder_) {
+        record(DrawCommand::Op::Blit, x, y, w, h, 0, data);
+        return;
+    }
+
+    x += originX_;
+    y += originY_;
+
+    Rect r = Rect::fromSize(x, y, w, h).clipped(clip_);
+    if (r.isEmpty()) return;
+
+    const uint8_t* start = data + ((r.y0 - y) * w + (r.x0 - x)) * 2;
+
+    if (band_) {
+        for (int16_t py = r.y0; py < r.y1; py++) {
+            std::memcpy(bandRow(py) + r.x0, start + (py - r.y0) * w * 2, r.width() * 2);
+        }
+        return;
+    }
+
+    writeWindow(r.x0, r.y0, r.width(), r.height(), start, (uint32_t)w * 2);
+}
+
+void Renderer::blitTransparent(int16_t x, int16_t y, uint16_t w, uint16_t h,
+                               const uint8_t* data, uint16_t transparentColor) {
+    if (recorder_) {
+        record(DrawCommand::Op::BlitTransparent, x, y, w, h, transparentColor, data);
+        return;
+    }
+
+    x += originX_;
+    y += originY_;
+
+    Rect r = Rect::fromSize(x, y, w, h).clipped(clip_);
+    if (r.isEmpty()) return;
+
+    const int16_t visibleW = r.width();
+    const int16_t firstCol = r.x0 - x;
+    const uint32_t stride = (uint32_t)w * 2;
+    const bool fullWidth = visibleW == (int16_t)w;
+
+    if (band_) {
+        for (int16_t py = r.y0; py < r.y1; py++) {
+            const uint8_t* line = data + (py - y) * stride + firstCol * 2;
+            uint8_t* out = reinterpret_cast<uint8_t*>(bandRow(py) + r.x0);
+            for (int16_t col = 0; col < visibleW; col++) {
+                if (((line[col * 2] << 8) | line[col * 2 + 1]) != transparentColor) {
+                    out[col * 2] = line[col * 2];
+                    out[col * 2 + 1] = line[col * 2 + 1];
+                }
+            }
+        }
+        return;
+    }
+
+    // Consecutive fully opaque rows, sent together as one window
+    int16_t blockStart = 0;
+    int16_t blockRows = 0;
+    auto flushBlock = [&]() {
+        if (blockRows > 0) {
+            const uint8_t* src = data + (blockStart - y) * stride;
+            writeWindow(r.x0, blockStart, visibleW, blockRows, src, stride);
+            blockRows = 0;
+        }
+    };
+
+    for (int16_t py = r.y0; py < r.y1; py++) {
+        const uint8_t* line = data + (py - y) * stride + firstCol * 2;
+
+        int16_t col = 0;
+        while (col < visibleW) {
+            // Skip transparent pixels
+            while (col < visibleW &&
+                   ((line[col * 2] << 8) | line[col * 2 + 1]) == transparentColor) {
+                col++;
+            }
+            int16_t runStart = col;
+            while (col < visibleW &&
+                   ((line[col * 2] << 8) | line[col * 2 + 1]) != transparentColor) {
+                col++;
+            }
+            if (col == runStart) break;
+
+            if (fullWidth && runStart == 0 && col == visibleW) {
+                if (blockRows > 0 && blockStart + blockRows != py) flushBlock();
+                if (blockRows == 0) blockStart = py;
+                blockRows++;
+            } else {
+                writeWindow(r.x0 + runStart, py, col - runStart, 1, line + runStart * 2, stride);
+            }
+        }
+    }
+    flushBlock();
+}
+
+void Renderer::blit16(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t* pixels) {
+    if (recorder_) {
+        record(DrawCommand::Op::Blit16, x, y, w, h, 0, pixels);
+        return;
+    }
+
+    x += originX_;
+    y += originY_;
+
+    Rect r = Rect::fromSize(x, y, w, h).clipped(clip_);
+    if (r.isEmpty()) return;
+
+    if (band_) {
+        for (int16_t py = r.y0; py < r.y1; py++) {
+            const uint16_t* src = pixels + (py - y) * w - x;
+            uint16_t* row = bandRow(py);
+            for (int16_t px = r.x0; px < r.x1; px++) {
+                row[px] = toWire(src[px]);
+            }
+        }
+        return;
+    }
+
+    // Swap into wire order in buffer-sized column segments, packing as many
+    // rows of a segment into one window as the buffer holds
+    for (int16_t segX = r.x0; segX < r.x1; segX += SWAP_BUFFER_PIXELS) {
+        uint16_t segW = (r.x1 - segX < SWAP_BUFFER_PIXELS) ? r.x1 - segX : SWAP_BUFFER_PIXELS;
+        uint16_t rowsPerWindow = SWAP_BUFFER_PIXELS / segW;
+
+        for (int16_t py = r.y0; py < r.y1; py += rowsPerWindow) {
+            uint16_t rows = (r.y1 - py < rowsPerWindow) ? r.y1 - py : rowsPerWindow;
+            uint8_t* staged = stagePixels(segW * rows);
+            uint8_t* out = staged;
+            for (uint16_t row = 0; row < rows; row++) {
+                const uint16_t* src = pixels + (py + row - y) * w + (segX - x);
+                for (uint16_t col = 0; col < segW; col++) {
+                    *out++ = src[col] >> 8;
+                    *out++ = src[col] & 0xFF;
+                }
+            }
+            writeWindow(segX, py, segW, rows, staged, (uint32_t)segW * 2);
+            swapFence_ = fence();
+        }
+    }
+}
+
+void Renderer::blit16Transparent(int16_t x, int16_t y, uint16_t w, uint16_t h,
+                                 const uint16_t* pixels, uint16_t transparentColor) {
+    if (recorder_) {
+        record(DrawCommand::Op::Blit16Transparent, x, y, w, h, transparentColor, pixels);
+        return;
+    }
+
+    x += originX_;
+    y += originY_;
+
+    Rect r = Rect::fromSize(x, y, w, h).clipped(clip_);
+    if (r.isEmpty()) return;
+
+    if (band_) {
+        for (int16_t py = r.y0; py < r.y1; py++) {
+            const uint16_t* src = pixels + (py - y) * w - x;
+            uint16_t* row = bandRow(py);
+            for (int16_t px = r.x0; px < r.x1; px++) {
+                if (src[px] != transparentColor) {
+                    row[px] = toWire(src[px]);
+                }
+            }
+        }
+        return;
+    }
+
+    for (int16_t py = r.y0; py < r.y1; py++) {
+        const uint16_t* line = pixels + (py - y) * w;
+        int16_t col = r.x0 - x;
+        const int16_t end = r.x1 - x;
+
+        while (col < end) {
+            while (col < end && line[col] == transparentColor) col++;
+
+            // Stage the opaque run, splitting it if it outgrows the buffer
+            int16_t runStart = col;
+            while (col < end && line[col] != transparentColor && col - runStart < SWAP_BUFFER_PIXELS) {
+                col++;
+            }
+            uint16_t run = col - runStart;
+            if (run > 0) {
+                uint8_t* staged = stagePixels(run);
+                for (uint16_t i = 0; i < run; i++) {
+                    staged[i * 2] = line[runStart + i] >> 8;
+                    staged[i * 2 + 1] = line[runStart + i] & 0xFF;
+                }
+                writeWindow(x + runStart, py, run, 1, staged, (uint32_t)run * 2);
+                swapFence_ = fence();
+            }
+        }
+    }
+}
+
+void Renderer::blitIndexed(int16_t x, int16_t y, const IndexedBitmap& bitmap) {
+    if (recorder_) {
+        record(DrawCommand::Op::BlitIndexed, x, y, bitmap.width, bitmap.height, 0, &bitmap);
+        return;
+    }
+
+    x += originX_;
+    y += originY_;
+
+    Rect r = Rect::fromSize(x, y, bitmap.width, bitmap.height).clipped(clip_);
+    if (r.isEmpty()) return;
+
+    const uint32_t rowBytes = bitmap.rowBytes();
+    const int16_t transparent = bitmap.transparentIndex;
+
+    // Palette entries are already in wire order, as bands store pixels
+    if (band_) {
+        for (int16_t py = r.y0; py < r.y1; py++) {
+            const uint8_t* line = bitmap.indices + (py - y) * rowBytes;
+            uint16_t* row = bandRow(py);
+            for (int16_t px = r.x0; px < r.x1; px++) {
+                uint8_t index = bitmap.indexAt(line, px - x);
+                if (index != transparent) {
+                    row[px] = bitmap.palette[index];
+                }
+            }
+        }
+        return;
+    }
+
+    if (transparent < 0) {
+        // Expand in buffer-sized column segments, as many rows per window as fit
+        for (int16_t segX = r.x0; segX < r.x1; segX += SWAP_BUFFER_PIXELS) {
+            uint16_t segW = (r.x1 - segX < SWAP_BUFFER_PIXELS) ? r.x1 - segX : SWAP_BUFFER_PIXELS;
+            uint16_t rowsPerWindow = SWAP_BUFFER_PIXELS / segW;
+
+            for (int16_t py = r.y0; py < r.y1; py += rowsPerWindow) {
+                uint16_t rows = (r.y1 - py < rowsPerWindow) ? r.y1 - py : rowsPerWindow;
+                uint8_t* staged = stagePixels(segW * rows);
+                uint16_t* out = reinterpret_cast<uint16_t*>(staged);
+                for (uint16_t row = 0; row < rows; row++) {
+                    const uint8_t* line = bitmap.indices + (py + row - y) * rowBytes;
+                    for (uint16_t col = 0; col < segW; col++) {
+                        *out++ = bitmap.palette[bitmap.indexAt(line, segX - x + col)];
+                    }
+                }
+                writeWindow(segX, py, segW, rows, staged, (uint32_t)segW * 2);
+                swapFence_ = fence();
+            }
+        }
+        return;
+    }
+
+    for (int16_t py = r.y0; py < r.y1; py++) {
+        const uint8_t* line = bitmap.indices + (py - y) * rowBytes;
+        int16_t col = r.x0 - x;
+        const int16_t end = r.x1 - x;
+
+        while (col < end) {
+            while (col < end && bitmap.indexAt(line, col) == transparent) col++;
+
+            // Expand the opaque run, splitting it if it outgrows the buffer
+            int16_t runStart = col;
+            while (col < end && bitmap.indexAt(line, col) != transparent &&
+                   col - runStart < SWAP_BUFFER_PIXELS) {
+                col++;
+            }
+            uint16_t run = col - runStart;
+            if (run > 0) {
+                uint16_t* staged = reinterpret_cast<uint16_t*>(stagePixels(run));
+                for (uint16_t i = 0; i < run; i++) {
+                    staged[i] = bitmap.palette[bitmap.indexAt(line, runStart + i)];
+                }
+                writeWindow(x + runStart, py, run, 1, reinterpret_cast<uint8_t*>(staged),
+                            (uint32_t)run * 2);
+                swapFence_ = fence();
+            }
+        }
+    }
+}
+
+void Renderer::blitRle(int16_t x, int16_t y, const RleBitmap& bitmap) {
+    if (recorder_) {
+        record(DrawCommand::Op::BlitRle, x, y, bitmap.width, bitmap.height, 0, &bitmap);
+        return;
+    }
+
+    x += originX_;
+    y += originY_;
+
+    Rect r = Rect::fromSize(x, y, bitmap.width, bitmap.height).clipped(clip_);
+    if (r.isEmpty()) return;
+
+    for (int16_t py = r.y0; py < r.y1; py++) {
+        const uint8_t* run = bitmap.data + bitmap.rowOffsets[py - y];
+        int32_t px = x;
+
+        // Walk runs until the visible part of the row is covered
+        while (px < r.x1) {
+            uint8_t control = *run++;
+            if (!(control & RleBitmap::OPAQUE)) {
+                px += control + 1;
+                continue;
+            }
+
+            int32_t length = (control & ~RleBitmap::OPAQUE) + 1;
+            int32_t start = px > r.x0 ? px : r.x0;
+            int32_t stop = px + length < r.x1 ? px + length : r.x1;
+            if (start < stop) {
+                const uint8_t* src = run + (start - px) * 2;
+                if (band_) {
+                    std::memcpy(bandRow(py) + start, src, (stop - start) * 2);
+                } else {
+                    writeWindow(start, py, stop - start, 1, src, (uint32_t)(stop - start) * 2);
+                }
+            }
+            run += length * 2;
+            px += length;
+        }
+    }
+}
+
+void Renderer::blitMasked(int16_t x, int16_t y, const MaskedBitmap& bitmap) {
+    if (recorder_) {
+        record(DrawCommand::Op::BlitMasked, x, y, bitmap.width, bitmap.height, 0, &bitmap);
+        return;
+    }
+
+    x += originX_;
+    y += originY_;
+
+    Rect r = Rect::fromSize(x, y, bitmap.width, bitmap.height).clipped(clip_);
+    if (r.isEmpty()) return;
+
+    const int16_t firstCol = r.x0 - x;
+    const int16_t endCol = r.x1 - x;
+    const uint32_t stride = (uint32_t)bitmap.width * 2;
+    const uint32_t maskStride = bitmap.maskRowBytes();
+    const bool fullWidth = r.width() == (int16_t)bitmap.width;
+
+    // Consecutive fully opaque rows, sent together as one window
+    int16_t blockStart = 0;
+    int16_t blockRows = 0;
+    auto flushBlock = [&]() {
+        if (blockRows > 0) {
+            const uint8_t* src = bitmap.data + (blockStart - y) * stride + firstCol * 2;
+            writeWindow(r.x0, blockStart, r.width(), blockRows, src, stride);
+            blockRows = 0;
+        }
+    };
+
+    for (int16_t py = r.y0; py < r.y1; py++) {
+        const uint8_t* line = bitmap.data + (py - y) * stride;
+        const uint8_t* mask = bitmap.mask + (py - y) * maskStride;
+
+        int16_t col = firstCol;
+        while (col < endCol) {
+            int16_t runStart = scanMask(mask, col, endCol, false);
+            col = scanMask(mask, runStart, endCol, true);
+            if (col == runStart) break;
+
+            if (band_) {
+                std::memcpy(bandRow(py) + x + runStart, line + runStart * 2, (col - runStart) * 2);
+            } else if (fullWidth && runStart == 0 && col == endCol) {
+                if (blockRows > 0 && blockStart + blockRows != py) flushBlock();
+                if (blockRows == 0) blockStart = py;
+                blockRows++;
+            } else {
+                writeWindow(x + runStart, py, col - runStart, 1, line + runStart * 2, stride);
+            }
+        }
+    }
+    flushBlock();
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstdint>
+#include "Rect.hpp"
+#include "displaylib_16/ili9341.hpp"
+#include "ili9341_dma.h"
+#include "DrawCommand.hpp"
+#include "Bitmap.hpp"
+
+// Drawing front end used by Game and GameObject::render.
+//
+// Every primitive is clipped to the screen and sent as address-window bursts:
+// one CASET/PASET/RAMWR setup followed by a run of pixel data, instead of a
+// window per pixel. Bitmaps are big-endian RGB565 bytes (the asset layout);
+// the *16 variants take native uint16_t pixels.
+//
+// With DMA enabled, fills and blits are queued on the display DMA engine and
+// return immediately; blit data must then stay unchanged until the fence
+// covering it is reached (always true for flash assets).
+//
+// While a band is set, the same calls rasterize into that in-RAM strip
+// instead of touching the panel (see StripCompositor). While a recorder is
+// set, they are queued as DrawCommands for another core to replay instead
+// (see RenderCore); bitmap data must then outlive the frame.
+class Renderer {
+public:
+    // CASET + PASET + RAMWR, each command byte plus parameters
+    static constexpr uint32_t WINDOW_SETUP_BYTES = 11;
+
+    Renderer(ILI9341_TFT& display, int16_t width, int16_t height);
+
+    // Raw display access for anything not covered here (not counted in stats).
+    // Waits for queued DMA work first so the SPI bus is free.
+    ILI9341_TFT& display() {
+        waitIdle();
+        return display_;
+    }
+
+    // Queue fills and blits on the DMA engine (requires display_dma_init)
+    void setDmaEnabled(bool enabled);
+    bool isDmaEnabled() const { return dmaEnabled_; }
+
+    // Fence covering everything drawn so far, and waits on it
+    display_dma_fence_t fence() const;
+    void wait(display_dma_fence_t fence) const;
+    void waitIdle() const;
+
+    int16_t getWidth() const { return bounds_.x1; }
+    int16_t getHeight() const { return bounds_.y1; }
+
+    // Redirect drawing into `pixels`, a buffer covering `area` in wire byte
+    // order; drawing is clipped to the area. Pass nullptr to draw to the panel.
+    void setBand(uint16_t* pixels, const Rect& area);
+    bool hasBand() const { return band_ != nullptr; }
+
+    // Queue every call on `queue` instead of drawing; nullptr to draw again
+    void setRecorder(DrawCommandQueue* queue) { recorder_ = queue; }
+    bool isRecording() const { return recorder_ != nullptr; }
+
+    // Offset every coordinate by (dx, dy) and clip drawing to `area`, in
+    // panel coordinates (a band still limits it further). Scrolling maps
+    // world rows onto frame memory this way. Recorded like any other call.
+    void setView(int16_t dx, int16_t dy, const Rect& area);
+    void resetView();
+
+    // Area drawing is currently clipped to (band and view, or the whole screen)
+    const Rect& getClip() const { return clip_; }
+
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void drawPixel(int16_t x, int16_t y, uint16_t color);
+
+    // Lines are clipped before rasterizing (Cohen-Sutherland outcodes reject
+    // lines wholly outside). Horizontal and vertical lines are one window;
+    // other lines send each run of pixels on the same row or column as one.
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+
+    // Midpoint circle outline, one window per horizontal or vertical run
+    void drawCircle(int16_t cx, int16_t cy, int16_t radius, uint16_t color);
+
+    // Filled shapes are rasterized into horizontal spans, each one fill
+    // window; consecutive rows with the same span share a window. The
+    // circle covers every pixel with dx*dx + dy*dy <= radius*radius.
+    void fillCircle(int16_t cx, int16_t cy, int16_t radius, uint16_t color);
+
+    // Pixels whose centers fall inside the shape (top-left rule, so
+    // polygons sharing an edge do not overlap). The polygon must be convex,
+    // in either winding, with coordinates within +/-16384; its spans are
+    // recorded as fills, so the vertex array need not outlive the call.
+    void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                      int16_t x2, int16_t y2, uint16_t color);
+    void fillPolygon(const Point* points, uint8_t count, uint16_t color);
+
+    // Opaque bitmap, one window for the whole visible area
+    void blit(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t* data);
+
+    // Skip pixels equal to transparentColor. Fully opaque rows are merged into
+    // one window; other rows get one window per opaque run.
+    void blitTransparent(int16_t x, int16_t y, uint16_t w, uint16_t h,
+                         const uint8_t* data, uint16_t transparentColor);
+
+    void blit16(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t* pixels);
+    void blit16Transparent(int16_t x, int16_t y, uint16_t w, uint16_t h,
+                           const uint16_t* pixels, uint16_t transparentColor);
+
+    // Palette-indexed bitmap, expanded through the staging buffer (or into
+    // the band) a window at a time; with a transparent index, one window per
+    // opaque run
+    void blitIndexed(int16_t x, int16_t y, const IndexedBitmap& bitmap);
+
+    // RLE bitmap: transparent runs are skipped whole, opaque runs are sent
+    // as windows straight from the source with no per-pixel work
+    void blitRle(int16_t x, int16_t y, const RleBitmap& bitmap);
+
+    // Pre-swapped bitmap with an opacity mask: opaque runs come from the
+    // mask and go out straight from the data; fully opaque rows are merged
+    // into one window as in blitTransparent()
+    void blitMasked(int16_t x, int16_t y, const MaskedBitmap& bitmap);
+
+    // SPI traffic since the last resetStats()
+    uint32_t getBytesSent() const { return bytesSent_; }
+    uint32_t getWindowCount() const { return windowCount_; }
+    void resetStats();
+
+private:
+    // Pixels staged per window when native pixels need byte swapping
+    static constexpr uint16_t SWAP_BUFFER_PIXELS = 256;
+
+    ILI9341_TFT& display_;
+    Rect bounds_;
+    Rect clip_;
+    Rect bandArea_;
+    Rect viewArea_;
+    int16_t originX_;
+    int16_t originY_;
+    uint16_t* band_;
+    DrawCommandQueue* recorder_;
+    bool dmaEnabled_;
+    uint32_t bytesSent_;
+    uint32_t windowCount_;
+
+    // Staging for swapped pixels; with DMA, windows queued from it must
+    // complete before the space is reused
+    alignas(4) uint8_t swapBuffer_[SWAP_BUFFER_PIXELS * 2];
+    uint16_t swapUsed_;
+    display_dma_fence_t swapFence_;
+
+    // Fill an area already offset and clipped
+    void fillArea(const Rect& r, uint16_t color);
+
+    // Reserve staging space for `pixels` (<= SWAP_BUFFER_PIXELS)
+    uint8_t* stagePixels(uint16_t pixels);
+
+    // Send a window of big-endian pixel bytes; rows are `stride` bytes apart
+    void writeWindow(int16_t x, int16_t y, uint16_t w, uint16_t h,
+                     const uint8_t* data, uint32_t stride);
+
+    // One address window of contiguous pixel bytes, direct or via DMA
+    void sendWindow(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t* data);
+
+    void countWindow(uint32_t pixels);
+
+    void record(DrawCommand::Op op, int16_t x, int16_t y, int16_t w, int16_t h,
+                uint16_t color, const void* data = nullptr) {
+        recorder_->push(DrawCommand{op, color, x, y, w, h, data});
+    }
+
+    // RGB565 value as stored in a band so its bytes land in wire order
+    static uint16_t toWire(uint16_t color) { return (color >> 8) | (color << 8); }
+
+    uint16_t* bandRow(int16_t y) {
+        return band_ + (y - bandArea_.y0) * bandArea_.width() - bandArea_.x0;
+    }
+
+    bool hasView() const { return originX_ != 0 || originY_ != 0 || viewArea_ != bounds_; }
+};
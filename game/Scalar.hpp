@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include "Fixed.hpp"
+
+// Number type the engine uses for positions, velocities and colliders.
+// Configure with -DPICO_GAME_FIXED_POINT=ON to switch from soft-float to
+// Q16.16 fixed point.
+#if PICO_GAME_FIXED_POINT
+using Scalar = Fixed;
+#else
+using Scalar = float;
+#endif
+
+// Math the vector and collider templates need, for both number types
+
+inline float scalarHypot(float x, float y) { return std::sqrt(x * x + y * y); }
+inline Fixed scalarHypot(Fixed x, Fixed y) { return Fixed::hypot(x, y); }
+
+inline float scalarSqrt(float value) { return std::sqrt(value); }
+inline Fixed scalarSqrt(Fixed value) { return Fixed::sqrt(value); }
+
+inline float scalarReciprocal(float value) { return 1.0f / value; }
+inline Fixed scalarReciprocal(Fixed value) { return Fixed::reciprocal(value); }
+
+inline int32_t floorToInt(float value) { return (int32_t)std::floor(value); }
+inline int32_t floorToInt(Fixed value) { return value.floorToInt(); }
+
+inline int32_t ceilToInt(float value) { return (int32_t)std::ceil(value); }
+inline int32_t ceilToInt(Fixed value) { return value.ceilToInt(); }
@@ -1,21 +1,45 @@
 #include "Screen.hpp"
 #include "pico/stdlib.h"
+#include "hardware/spi.h"
+#include "ili9341_dma.h"
+
+namespace {
+constexpr int8_t TFT_RST = 20;
+constexpr int8_t TFT_DC = 21;
+constexpr int8_t TFT_CS = 17;
+constexpr int8_t TFT_SCLK = 18;
+constexpr int8_t TFT_MOSI = 19;
+constexpr int8_t TFT_MISO = 16;
+
+// ILI9341 vertical scroll commands
+constexpr uint8_t ILI9341_VSCRDEF = 0x33;
+constexpr uint8_t ILI9341_VSCRSADD = 0x37;
+}
 
 Screen::Screen() {
-    display_.SetupGPIO(20, 21, 17, 18, 19, 16);
-    display_.SetupScreenSize(240, 320);
+    display_.SetupGPIO(TFT_RST, TFT_DC, TFT_CS, TFT_SCLK, TFT_MOSI, TFT_MISO);
+    display_.SetupScreenSize(WIDTH, HEIGHT);
     display_.SetupSPI(62500000, spi0);
     display_.ILI9341Initialize();
     
     ts_spi_setup();  // Initialize touch screen
     
     display_.fillScreen(display_.C_BLACK);
+
+    // Shares spi0 and the DC/CS pins displaylib just configured
+    dmaReady_ = display_dma_init(spi0, TFT_DC, TFT_CS);
 }
 
 ILI9341_TFT& Screen::display() {
+    // Queued DMA transfers own the bus until they finish
+    display_dma_wait_idle();
     return display_;
 }
 
+bool Screen::isDmaReady() const {
+    return dmaReady_;
+}
+
 bool Screen::isTouchPressed() const {
     return gpio_get(TS_IRQ_PIN) == 0;
 }
@@ -25,6 +49,9 @@ bool Screen::readTouch(uint16_t& x, uint16_t& y) {
         return false;
     }
 
+    // Touch controller is on the display's SPI bus
+    display_dma_wait_idle();
+
     x = ts_get_x();
     y = ts_get_y();
 
@@ -36,5 +63,36 @@ bool Screen::readTouch(uint16_t& x, uint16_t& y) {
 }
 
 void Screen::clear(uint16_t color) {
-    display_.fillScreen(color);
+    display().fillScreen(color);
+}
+
+void Screen::setScrollArea(uint16_t top, uint16_t height) {
+    // Top fixed, scrolling and bottom fixed heights must add up to the panel
+    uint16_t bottom = HEIGHT - top - height;
+    uint8_t params[6] = {
+        (uint8_t)(top >> 8), (uint8_t)top,
+        (uint8_t)(height >> 8), (uint8_t)height,
+        (uint8_t)(bottom >> 8), (uint8_t)bottom
+    };
+    writeCommand(ILI9341_VSCRDEF, params, sizeof(params));
+}
+
+void Screen::setScrollStart(uint16_t line) {
+    uint8_t params[2] = { (uint8_t)(line >> 8), (uint8_t)line };
+    writeCommand(ILI9341_VSCRSADD, params, sizeof(params));
+}
+
+void Screen::writeCommand(uint8_t cmd, const uint8_t* params, uint8_t count) {
+    if (dmaReady_) {
+        display_dma_command(cmd, params, count);
+        return;
+    }
+
+    // displaylib releases CS after every transaction, so the bus is free here
+    gpio_put(TFT_CS, 0);
+    gpio_put(TFT_DC, 0);
+    spi_write_blocking(spi0, &cmd, 1);
+    gpio_put(TFT_DC, 1);
+    spi_write_blocking(spi0, params, count);
+    gpio_put(TFT_CS, 1);
 }
@@ -9,12 +9,31 @@ extern "C" {
 
 class Screen {
 public:
+    static constexpr int16_t WIDTH = 240;
+    static constexpr int16_t HEIGHT = 320;
+
     Screen();
     ILI9341_TFT& display();
     bool isTouchPressed() const;
     bool readTouch(uint16_t& x, uint16_t& y);
     void clear(uint16_t color = 0x0000);
 
+    // True if the display DMA queue was set up (see ili9341_dma.h)
+    bool isDmaReady() const;
+
+    // Hardware vertical scroll (VSCRDEF). Rows [top, top + height) scroll;
+    // the rows above and below stay fixed.
+    void setScrollArea(uint16_t top, uint16_t height);
+
+    // Frame memory row shown on the first line of the scroll area, in
+    // [top, top + height) (VSCRSADD). With DMA the change is queued behind
+    // everything drawn so far.
+    void setScrollStart(uint16_t line);
+
 private:
     ILI9341_TFT display_;
+    bool dmaReady_;
+
+    // Send a command with parameters, through the DMA queue when it is up
+    void writeCommand(uint8_t cmd, const uint8_t* params, uint8_t count);
 };
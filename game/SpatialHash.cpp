@@ -0,0 +1,81 @@
+#include "SpatialHash.hpp"
+
+SpatialHash::SpatialHash(int16_t width, int16_t height)
+    : columns_((width + CELL_SIZE - 1) >> CELL_SHIFT),
+      rows_((height + CELL_SIZE - 1) >> CELL_SHIFT), originX_(0), originY_(0),
+      cellStart_(columns_ * rows_ + 1, 0), cellPairs_(0), candidatePairs_(0) {}
+
+void SpatialHash::clear() {
+    ids_.clear();
+    bounds_.clear();
+}
+
+void SpatialHash::insert(uint16_t id, const Rect& bounds) {
+    ids_.push_back(id);
+    bounds_.push_back(bounds);
+}
+
+void SpatialHash::build() {
+    // Counting sort: count entries per cell, turn counts into start offsets,
+    // then drop each entry into its cells
+    size_t cells = (size_t)columns_ * rows_;
+    for (size_t c = 0; c <= cells; c++) {
+        cellStart_[c] = 0;
+    }
+
+    size_t total = 0;
+    for (const Rect& r : bounds_) {
+        uint16_t cx0, cy0, cx1, cy1;
+        cellRange(r, cx0, cy0, cx1, cy1);
+        for (uint16_t cy = cy0; cy <= cy1; cy++) {
+            for (uint16_t cx = cx0; cx <= cx1; cx++) {
+                cellStart_[cy * columns_ + cx + 1]++;
+                total++;
+            }
+        }
+    }
+
+    for (size_t c = 1; c <= cells; c++) {
+        cellStart_[c] += cellStart_[c - 1];
+    }
+
+    cellEntries_.resize(total);
+    std::vector<uint32_t>& fill = cellStart_;
+    for (uint16_t e = 0; e < bounds_.size(); e++) {
+        uint16_t cx0, cy0, cx1, cy1;
+        cellRange(bounds_[e], cx0, cy0, cx1, cy1);
+        for (uint16_t cy = cy0; cy <= cy1; cy++) {
+            for (uint16_t cx = cx0; cx <= cx1; cx++) {
+                cellEntries_[fill[cy * columns_ + cx]++] = e;
+            }
+        }
+    }
+
+    // The fill pass advanced each start to the next cell's start; shift back
+    for (size_t c = cells; c > 0; c--) {
+        cellStart_[c] = cellStart_[c - 1];
+    }
+    cellStart_[0] = 0;
+}
+
+uint16_t SpatialHash::cellX(int16_t x) const {
+    int32_t local = (int32_t)x - originX_;
+    if (local < 0) return 0;
+    uint32_t cx = local >> CELL_SHIFT;
+    return cx < columns_ ? cx : columns_ - 1;
+}
+
+uint16_t SpatialHash::cellY(int16_t y) const {
+    int32_t local = (int32_t)y - originY_;
+    if (local < 0) return 0;
+    uint32_t cy = local >> CELL_SHIFT;
+    return cy < rows_ ? cy : rows_ - 1;
+}
+
+void SpatialHash::cellRange(const Rect& r, uint16_t& cx0, uint16_t& cy0,
+                            uint16_t& cx1, uint16_t& cy1) const {
+    cx0 = cellX(r.x0);
+    cy0 = cellY(r.y0);
+    cx1 = cellX(r.x1 > r.x0 ? r.x1 - 1 : r.x0);
+    cy1 = cellY(r.y1 > r.y0 ? r.y1 - 1 : r.y0);
+}
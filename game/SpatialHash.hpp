@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "Rect.hpp"
+
+// Uniform grid broadphase over the screen.
+//
+// Each frame: clear(), insert() every collidable with its pixel bounds,
+// build(), then forEachPair() visits each pair of entries whose bounds share
+// a cell, exactly once. Entries outside the grid are clamped into the edge
+// cells, so off-screen objects still collide with each other.
+//
+// Storage is reused between frames; after the first few frames no further
+// allocation happens unless the entry count reaches a new high.
+class SpatialHash {
+public:
+    static constexpr uint8_t CELL_SHIFT = 5;  // 32x32 pixel cells
+    static constexpr int16_t CELL_SIZE = 1 << CELL_SHIFT;
+
+    SpatialHash(int16_t width, int16_t height);
+
+    void clear();
+
+    // World position of the grid's top-left corner (scrolling playfields
+    // keep the grid over the visible window)
+    void setOrigin(int16_t x, int16_t y) { originX_ = x; originY_ = y; }
+
+    // Add an entry; ids are reported back by forEachPair()
+    void insert(uint16_t id, const Rect& bounds);
+
+    // Sort entries into cells; call after the last insert()
+    void build();
+
+    // Call visit(idA, idB) for every pair whose bounds overlap, each pair
+    // once, with A inserted before B
+    template <typename Visit>
+    void forEachPair(Visit&& visit);
+
+    uint16_t getColumns() const { return columns_; }
+    uint16_t getRows() const { return rows_; }
+    size_t getEntryCount() const { return bounds_.size(); }
+
+    // Pairs found sharing a cell (counting duplicates across cells), and
+    // distinct overlapping pairs handed to visit, during the last forEachPair()
+    uint32_t getCellPairCount() const { return cellPairs_; }
+    uint32_t getCandidatePairCount() const { return candidatePairs_; }
+
+private:
+    uint16_t columns_;
+    uint16_t rows_;
+    int16_t originX_;
+    int16_t originY_;
+
+    std::vector<uint16_t> ids_;
+    std::vector<Rect> bounds_;
+    std::vector<uint32_t> cellStart_;  // Per cell start into cellEntries_, plus end
+    std::vector<uint16_t> cellEntries_;
+
+    uint32_t cellPairs_;
+    uint32_t candidatePairs_;
+
+    uint16_t cellX(int16_t x) const;
+    uint16_t cellY(int16_t y) const;
+
+    // Inclusive cell range covered by a rectangle (at least one cell)
+    void cellRange(const Rect& r, uint16_t& cx0, uint16_t& cy0,
+                   uint16_t& cx1, uint16_t& cy1) const;
+};
+
+template <typename Visit>
+void SpatialHash::forEachPair(Visit&& visit) {
+    cellPairs_ = 0;
+    candidatePairs_ = 0;
+
+    for (uint16_t cy = 0; cy < rows_; cy++) {
+        for (uint16_t cx = 0; cx < columns_; cx++) {
+            uint16_t cell = cy * columns_ + cx;
+            uint32_t begin = cellStart_[cell];
+            uint32_t end = cellStart_[cell + 1];
+
+            for (uint32_t i = begin; i < end; i++) {
+                uint16_t a = cellEntries_[i];
+                const Rect& ra = bounds_[a];
+
+                for (uint32_t j = i + 1; j < end; j++) {
+                    uint16_t b = cellEntries_[j];
+                    const Rect& rb = bounds_[b];
+                    cellPairs_++;
+
+                    // Zero-size bounds can still touch in the narrowphase
+                    if (!ra.isEmpty() && !rb.isEmpty() && !ra.intersects(rb)) continue;
+
+                    // A pair spanning several cells is reported only from the
+                    // cell holding the top-left corner of its overlap
+                    int16_t ox = ra.x0 > rb.x0 ? ra.x0 : rb.x0;
+                    int16_t oy = ra.y0 > rb.y0 ? ra.y0 : rb.y0;
+                    if (cellX(ox) != cx || cellY(oy) != cy) continue;
+
+                    candidatePairs_++;
+                    if (a < b) {
+                        visit(ids_[a], ids_[b]);
+                    } else {
+                        visit(ids_[b], ids_[a]);
+                    }
+                }
+            }
+        }
+    }
+}
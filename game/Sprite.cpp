@@ -2,28 +2,50 @@
 
 Sprite::Sprite(const uint8_t* bitmap, uint16_t w, uint16_t h, 
                const Vector2& pos, uint16_t transColor)
-    : GameObject(pos, BoxCollider((float)w, (float)h)), 
-      bitmapData(bitmap), width(w), height(h), transparentColor(transColor) {
+    : GameObject(pos, BoxCollider(w, h)), 
+      bitmapData(bitmap), width(w), height(h), transparentColor(transColor),
+      indexedBitmap(nullptr), rleBitmap(nullptr), maskedBitmap(nullptr), format(Format::Rgb565) {
 }
 
-void Sprite::render(ILI9341_TFT& display) {
+Sprite::Sprite(const IndexedBitmap& bitmap, const Vector2& pos)
+    : GameObject(pos, BoxCollider(bitmap.width, bitmap.height)),
+      bitmapData(nullptr), width(bitmap.width), height(bitmap.height), transparentColor(0),
+      indexedBitmap(&bitmap), rleBitmap(nullptr), maskedBitmap(nullptr), format(Format::Indexed) {
+}
+
+Sprite::Sprite(const RleBitmap& bitmap, const Vector2& pos)
+    : GameObject(pos, BoxCollider(bitmap.width, bitmap.height)),
+      bitmapData(nullptr), width(bitmap.width), height(bitmap.height), transparentColor(0),
+      indexedBitmap(nullptr), rleBitmap(&bitmap), maskedBitmap(nullptr), format(Format::Rle) {
+}
+
+Sprite::Sprite(const MaskedBitmap& bitmap, const Vector2& pos)
+    : GameObject(pos, BoxCollider(bitmap.width, bitmap.height)),
+      bitmapData(nullptr), width(bitmap.width), height(bitmap.height), transparentColor(0),
+      indexedBitmap(nullptr), rleBitmap(nullptr), maskedBitmap(&bitmap), format(Format::Masked) {
+}
+
+void Sprite::render(Renderer& renderer) {
     if (!visible) return;
-    
-    uint16_t x = (uint16_t)position.x;
-    uint16_t y = (uint16_t)position.y;
-    
-    for (uint16_t py = 0; py < height; py++) {
-        for (uint16_t px = 0; px < width; px++) {
-            int index = (py * width + px) * 2;
-            uint16_t color = (bitmapData[index] << 8) | bitmapData[index + 1];
-            
-            if (color != transparentColor) {
-                display.drawPixel(x + px, y + py, color);
-            }
-        }
+
+    int16_t x = (int16_t)position.x;
+    int16_t y = (int16_t)position.y;
+    switch (format) {
+        case Format::Rgb565:
+            renderer.blitTransparent(x, y, width, height, bitmapData, transparentColor);
+            break;
+        case Format::Indexed:
+            renderer.blitIndexed(x, y, *indexedBitmap);
+            break;
+        case Format::Rle:
+            renderer.blitRle(x, y, *rleBitmap);
+            break;
+        case Format::Masked:
+            renderer.blitMasked(x, y, *maskedBitmap);
+            break;
     }
 }
 
-void Sprite::renderTransparent(ILI9341_TFT& display) {
-    render(display);
+void Sprite::renderTransparent(Renderer& renderer) {
+    render(renderer);
 }
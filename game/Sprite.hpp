@@ -3,25 +3,49 @@
 #include <cstdint>
 #include "Vector.hpp"
 #include "GameObject.hpp"
+#include "Bitmap.hpp"
 
 class Sprite : public GameObject {
+public:
+    // Pixel source: RGB565 bytes with a color key, or a compact Bitmap.hpp format
+    enum class Format {
+        Rgb565,
+        Indexed,
+        Rle,
+        Masked
+    };
+
 protected:
     const uint8_t* bitmapData;
     uint16_t width;
     uint16_t height;
     uint16_t transparentColor;
+    const IndexedBitmap* indexedBitmap;
+    const RleBitmap* rleBitmap;
+    const MaskedBitmap* maskedBitmap;
+    Format format;
 
 public:
     Sprite(const uint8_t* bitmap, uint16_t w, uint16_t h, 
-           const Vector2& pos = Vector2(0.0f, 0.0f), 
+           const Vector2& pos = Vector2(0, 0), 
            uint16_t transColor = 0x0000);
+    Sprite(const IndexedBitmap& bitmap, const Vector2& pos = Vector2(0, 0));
+    Sprite(const RleBitmap& bitmap, const Vector2& pos = Vector2(0, 0));
+    Sprite(const MaskedBitmap& bitmap, const Vector2& pos = Vector2(0, 0));
     
     virtual ~Sprite() = default;
 
-    void render(ILI9341_TFT& display) override;
-    void renderTransparent(ILI9341_TFT& display);
+    // Opaque runs go out as windowed bursts; transparentColor pixels are skipped
+    void render(Renderer& renderer) override;
+    void renderTransparent(Renderer& renderer);
     
     uint16_t getWidth() const { return width; }
     uint16_t getHeight() const { return height; }
+    Format getFormat() const { return format; }
+
+    // Swap frames; a different format or size must not be set this way
     void setBitmap(const uint8_t* bitmap) { bitmapData = bitmap; }
+    void setBitmap(const IndexedBitmap& bitmap) { indexedBitmap = &bitmap; }
+    void setBitmap(const RleBitmap& bitmap) { rleBitmap = &bitmap; }
+    void setBitmap(const MaskedBitmap& bitmap) { maskedBitmap = &bitmap; }
 };
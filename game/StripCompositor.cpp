@@ -0,0 +1,42 @@
+#include "StripCompositor.hpp"
+
+StripCompositor::StripCompositor(Renderer& renderer)
+    : renderer_(renderer),
+      strips_(new uint16_t[2 * renderer.getWidth() * STRIP_HEIGHT]),
+      fences_{0, 0}, current_(0) {}
+
+StripCompositor::~StripCompositor() {
+    // A strip may still be streaming out of the buffer
+    renderer_.setBand(nullptr, Rect());
+    renderer_.waitIdle();
+}
+
+int16_t StripCompositor::getBandCount() const {
+    return (renderer_.getHeight() + STRIP_HEIGHT - 1) / STRIP_HEIGHT;
+}
+
+Rect StripCompositor::getBandRect(int16_t index) const {
+    Rect band = Rect::fromSize(0, index * STRIP_HEIGHT, renderer_.getWidth(), STRIP_HEIGHT);
+    return band.clipped(Rect(0, 0, renderer_.getWidth(), renderer_.getHeight()));
+}
+
+void StripCompositor::beginBand(int16_t index, uint16_t clearColor) {
+    current_ ^= 1;
+
+    // The strip may still be feeding the last band it held
+    renderer_.wait(fences_[current_]);
+
+    bandRect_ = getBandRect(index);
+    uint16_t* strip = strips_.get() + current_ * renderer_.getWidth() * STRIP_HEIGHT;
+    renderer_.setBand(strip, bandRect_);
+    renderer_.fillRect(bandRect_.x0, bandRect_.y0, bandRect_.width(), bandRect_.height(), clearColor);
+}
+
+void StripCompositor::endBand() {
+    const uint8_t* strip = reinterpret_cast<const uint8_t*>(
+        strips_.get() + current_ * renderer_.getWidth() * STRIP_HEIGHT);
+
+    renderer_.setBand(nullptr, Rect());
+    renderer_.blit(bandRect_.x0, bandRect_.y0, bandRect_.width(), bandRect_.height(), strip);
+    fences_[current_] = renderer_.fence();
+}
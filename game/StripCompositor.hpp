@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include "Rect.hpp"
+#include "Renderer.hpp"
+
+// Composes the frame in full-width horizontal bands instead of a full-screen
+// framebuffer: each band is rasterized into an in-RAM strip with normal
+// overdraw, then pushed to the panel as a single window. Two strips are used
+// in turn, so with DMA the next band is composed while the previous one is
+// still being sent.
+//
+// Memory: 2 * width * STRIP_HEIGHT * 2 bytes (30 KB for 240x32 strips).
+class StripCompositor {
+public:
+    static constexpr int16_t STRIP_HEIGHT = 32;
+
+    StripCompositor(Renderer& renderer);
+    ~StripCompositor();
+
+    int16_t getBandCount() const;
+    Rect getBandRect(int16_t index) const;
+
+    // Point the renderer at a free strip covering the band, cleared to color
+    void beginBand(int16_t index, uint16_t clearColor);
+
+    // Send the composed strip and return the renderer to the panel
+    void endBand();
+
+private:
+    Renderer& renderer_;
+    std::unique_ptr<uint16_t[]> strips_;
+    display_dma_fence_t fences_[2];
+    int current_;
+    Rect bandRect_;
+};
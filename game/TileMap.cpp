@@ -0,0 +1,129 @@
+#include "TileMap.hpp"
+#include <cstring>
+
+TileMap::TileMap(const TileSet& tiles, const uint8_t* cells, uint16_t mapWidth, uint16_t mapHeight,
+                 int16_t viewWidth, int16_t viewHeight)
+    : tiles_(tiles), cells_(cells), mapWidth_(mapWidth), mapHeight_(mapHeight),
+      emptyColor_(0x0000),
+      cacheColumns_((viewWidth + tiles.size - 1) / tiles.size + 1),
+      cacheRows_((viewHeight + tiles.size - 1) / tiles.size + 1),
+      cache_(new uint8_t[cacheColumns_ * cacheRows_]),
+      changed_(new uint32_t[(cacheColumns_ * cacheRows_ + 31) / 32]()),
+      changedCount_(0), loaded_(false), cacheX_(0), cacheY_(0), streamedTiles_(0) {}
+
+int16_t TileMap::tileOf(int16_t v) const {
+    return v >= 0 ? v / tiles_.size : -((-v + tiles_.size - 1) / tiles_.size);
+}
+
+uint16_t TileMap::slot(int16_t tx, int16_t ty) const {
+    uint16_t col = ((tx % cacheColumns_) + cacheColumns_) % cacheColumns_;
+    uint16_t row = ((ty % cacheRows_) + cacheRows_) % cacheRows_;
+    return row * cacheColumns_ + col;
+}
+
+uint8_t TileMap::readMap(int16_t tx, int16_t ty) const {
+    if (tx < 0 || ty < 0 || tx >= mapWidth_ || ty >= mapHeight_) {
+        return EMPTY;
+    }
+    return cells_[(uint32_t)ty * mapWidth_ + tx];
+}
+
+void TileMap::load(int16_t tx, int16_t ty) {
+    uint16_t s = slot(tx, ty);
+    cache_[s] = readMap(tx, ty);
+    if (changed_[s >> 5] & (1u << (s & 31))) {
+        changed_[s >> 5] &= ~(1u << (s & 31));
+        changedCount_--;
+    }
+    streamedTiles_++;
+}
+
+void TileMap::setView(const Rect& view) {
+    int16_t x0 = tileOf(view.x0);
+    int16_t y0 = tileOf(view.y0);
+
+    // Reload everything after a jump; otherwise only the rows and columns
+    // that came into the window
+    if (!loaded_ || x0 >= cacheX_ + cacheColumns_ || x0 + cacheColumns_ <= cacheX_ ||
+        y0 >= cacheY_ + cacheRows_ || y0 + cacheRows_ <= cacheY_) {
+        std::memset(changed_.get(), 0, ((cacheColumns_ * cacheRows_ + 31) / 32) * sizeof(uint32_t));
+        changedCount_ = 0;
+        for (int16_t ty = y0; ty < y0 + cacheRows_; ty++) {
+            for (int16_t tx = x0; tx < x0 + cacheColumns_; tx++) {
+                load(tx, ty);
+            }
+        }
+    } else if (x0 != cacheX_ || y0 != cacheY_) {
+        for (int16_t ty = y0; ty < y0 + cacheRows_; ty++) {
+            bool rowCached = ty >= cacheY_ && ty < cacheY_ + cacheRows_;
+            for (int16_t tx = x0; tx < x0 + cacheColumns_; tx++) {
+                if (!rowCached || tx < cacheX_ || tx >= cacheX_ + cacheColumns_) {
+                    load(tx, ty);
+                }
+            }
+        }
+    }
+
+    loaded_ = true;
+    cacheX_ = x0;
+    cacheY_ = y0;
+}
+
+uint8_t TileMap::getTile(int16_t tx, int16_t ty) const {
+    if (isCached(tx, ty)) {
+        return cache_[slot(tx, ty)];
+    }
+    return readMap(tx, ty);
+}
+
+bool TileMap::setTile(int16_t tx, int16_t ty, uint8_t index) {
+    if (!isCached(tx, ty)) return false;
+
+    uint16_t s = slot(tx, ty);
+    if (cache_[s] == index) return true;
+
+    cache_[s] = index;
+    if (!(changed_[s >> 5] & (1u << (s & 31)))) {
+        changed_[s >> 5] |= 1u << (s & 31);
+        changedCount_++;
+    }
+    return true;
+}
+
+Rect TileMap::getTileRect(int16_t tx, int16_t ty) const {
+    return Rect::fromSize(tx * tiles_.size, ty * tiles_.size, tiles_.size, tiles_.size);
+}
+
+void TileMap::collectDirty(DirtyRegion& region) {
+    if (changedCount_ == 0) return;
+
+    for (int16_t ty = cacheY_; ty < cacheY_ + cacheRows_; ty++) {
+        for (int16_t tx = cacheX_; tx < cacheX_ + cacheColumns_; tx++) {
+            uint16_t s = slot(tx, ty);
+            if (changed_[s >> 5] & (1u << (s & 31))) {
+                region.add(getTileRect(tx, ty));
+                changed_[s >> 5] &= ~(1u << (s & 31));
+            }
+        }
+    }
+    changedCount_ = 0;
+}
+
+uint16_t TileMap::draw(Renderer& renderer, const Rect& area) const {
+    if (area.isEmpty()) return 0;
+
+    const uint8_t size = tiles_.size;
+    uint16_t drawn = 0;
+    for (int16_t ty = tileOf(area.y0); ty <= tileOf(area.y1 - 1); ty++) {
+        for (int16_t tx = tileOf(area.x0); tx <= tileOf(area.x1 - 1); tx++) {
+            uint8_t index = getTile(tx, ty);
+            if (index == EMPTY || index >= tiles_.count) {
+                renderer.fillRect(tx * size, ty * size, size, size, emptyColor_);
+            } else {
+                renderer.blit(tx * size, ty * size, size, size, tiles_.tile(index));
+            }
+            drawn++;
+        }
+    }
+    return drawn;
+}
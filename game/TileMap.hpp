@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include "Rect.hpp"
+#include "DirtyRegion.hpp"
+#include "Renderer.hpp"
+
+// Square tiles stored back to back, each size * size big-endian RGB565
+// pixels (the wire order), so one tile is one contiguous window burst.
+// Normally a const array in flash; blits stream straight from XIP.
+struct TileSet {
+    const uint8_t* pixels;
+    uint16_t count;
+    uint8_t size;
+
+    const uint8_t* tile(uint8_t index) const { return pixels + (uint32_t)index * size * size * 2; }
+};
+
+// Background grid of tile indices with its top-left tile at world (0, 0)
+// (Game::setTileMap).
+//
+// The full map stays where it is, usually in flash. Only a window of
+// indices covering the view plus one tile each way is kept in RAM, and
+// setView() streams in the rows and columns the view moves onto, so memory
+// stays fixed however large the level is. setTile() edits the cached copy
+// and marks the tile for redrawing; edits are lost once the tile streams
+// out, so keep persistent level state in a RAM map.
+class TileMap {
+public:
+    // Cells drawn as a solid emptyColor fill: outside the map, or this index
+    static constexpr uint8_t EMPTY = 0xFF;
+
+    // `cells` is mapWidth x mapHeight indices, row-major. The cache is sized
+    // for views up to viewWidth x viewHeight pixels.
+    TileMap(const TileSet& tiles, const uint8_t* cells, uint16_t mapWidth, uint16_t mapHeight,
+            int16_t viewWidth, int16_t viewHeight);
+
+    const TileSet& getTileSet() const { return tiles_; }
+    uint8_t getTileSize() const { return tiles_.size; }
+    uint16_t getMapWidth() const { return mapWidth_; }
+    uint16_t getMapHeight() const { return mapHeight_; }
+
+    void setEmptyColor(uint16_t color) { emptyColor_ = color; }
+    uint16_t getEmptyColor() const { return emptyColor_; }
+
+    // Stream in the tiles covering `view` (world pixels)
+    void setView(const Rect& view);
+
+    // Tile at tile coordinates: the cached copy if loaded, else the map
+    uint8_t getTile(int16_t tx, int16_t ty) const;
+
+    // Change a cached tile; false if it isn't in the cached window
+    bool setTile(int16_t tx, int16_t ty, uint8_t index);
+
+    // World rectangle covered by a tile
+    Rect getTileRect(int16_t tx, int16_t ty) const;
+
+    // Add the rectangles of tiles changed since the last call
+    void collectDirty(DirtyRegion& region);
+
+    // Blit every tile touching `area`, whole (clip with the renderer);
+    // returns the number of tiles sent
+    uint16_t draw(Renderer& renderer, const Rect& area) const;
+
+    // Tiles read from the map into the cache so far
+    uint32_t getStreamedTiles() const { return streamedTiles_; }
+
+private:
+    TileSet tiles_;
+    const uint8_t* cells_;
+    uint16_t mapWidth_;
+    uint16_t mapHeight_;
+    uint16_t emptyColor_;
+
+    // Ring of cached indices: tile (tx, ty) lives in slot
+    // (ty mod cacheRows_, tx mod cacheColumns_)
+    uint16_t cacheColumns_;
+    uint16_t cacheRows_;
+    std::unique_ptr<uint8_t[]> cache_;
+    std::unique_ptr<uint32_t[]> changed_;  // One bit per slot
+    uint16_t changedCount_;
+    bool loaded_;
+    int16_t cacheX_;  // Tile coordinates of the first cached column and row
+    int16_t cacheY_;
+    uint32_t streamedTiles_;
+
+    bool isCached(int16_t tx, int16_t ty) const {
+        return loaded_ && tx >= cacheX_ && tx < cacheX_ + cacheColumns_ &&
+               ty >= cacheY_ && ty < cacheY_ + cacheRows_;
+    }
+
+    uint16_t slot(int16_t tx, int16_t ty) const;
+    uint8_t readMap(int16_t tx, int16_t ty) const;
+    void load(int16_t tx, int16_t ty);
+
+    // Tile containing a world coordinate (floor division)
+    int16_t tileOf(int16_t v) const;
+};
@@ -1,87 +1,92 @@
 #pragma once
 
-#include <cmath>
+#include "Scalar.hpp"
 
-class Vector2 {
+// 2D vector over float or Fixed; the engine uses Vector2 (Vector2T<Scalar>)
+template <typename T>
+class Vector2T {
 public:
-    float x, y;
+    T x, y;
 
-    Vector2(float x = 0.0f, float y = 0.0f) : x(x), y(y) {}
+    Vector2T(T x = T(0), T y = T(0)) : x(x), y(y) {}
 
     // Vector addition
-    Vector2 operator+(const Vector2& other) const {
-        return Vector2(x + other.x, y + other.y);
+    Vector2T operator+(const Vector2T& other) const {
+        return Vector2T(x + other.x, y + other.y);
     }
 
     // Vector subtraction
-    Vector2 operator-(const Vector2& other) const {
-        return Vector2(x - other.x, y - other.y);
+    Vector2T operator-(const Vector2T& other) const {
+        return Vector2T(x - other.x, y - other.y);
     }
 
     // Scalar multiplication
-    Vector2 operator*(float scalar) const {
-        return Vector2(x * scalar, y * scalar);
+    Vector2T operator*(T scalar) const {
+        return Vector2T(x * scalar, y * scalar);
     }
 
     // Scalar division
-    Vector2 operator/(float scalar) const {
-        if (scalar != 0.0f) {
-            return Vector2(x / scalar, y / scalar);
+    Vector2T operator/(T scalar) const {
+        if (scalar != T(0)) {
+            return Vector2T(x / scalar, y / scalar);
         }
-        return Vector2(0.0f, 0.0f);
+        return Vector2T(T(0), T(0));
     }
 
     // Dot product
-    float dot(const Vector2& other) const {
+    T dot(const Vector2T& other) const {
         return x * other.x + y * other.y;
     }
 
     // Magnitude (length)
-    float magnitude() const {
-        return std::sqrt(x * x + y * y);
+    T magnitude() const {
+        return scalarHypot(x, y);
     }
 
-    // Square magnitude (faster, no sqrt)
-    float sqrMagnitude() const {
+    // Square magnitude (faster, no sqrt). Fixed overflows past ~181 units.
+    T sqrMagnitude() const {
         return x * x + y * y;
     }
 
     // Normalized vector (unit vector)
-    Vector2 normalized() const {
-        float mag = magnitude();
-        if (mag > 0.0f) {
-            return Vector2(x / mag, y / mag);
+    Vector2T normalized() const {
+        T mag = magnitude();
+        if (mag > T(0)) {
+            T inv = scalarReciprocal(mag);
+            return Vector2T(x * inv, y * inv);
         }
-        return Vector2(0.0f, 0.0f);
+        return Vector2T(T(0), T(0));
     }
 
     // Distance between two points
-    float distance(const Vector2& other) const {
+    T distance(const Vector2T& other) const {
         return (*this - other).magnitude();
     }
 
     // Lerp (linear interpolation) between two vectors
-    static Vector2 lerp(const Vector2& a, const Vector2& b, float t) {
-        if (t < 0.0f) t = 0.0f;
-        if (t > 1.0f) t = 1.0f;
-        return Vector2(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t);
+    static Vector2T lerp(const Vector2T& a, const Vector2T& b, T t) {
+        if (t < T(0)) t = T(0);
+        if (t > T(1)) t = T(1);
+        return Vector2T(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t);
     }
 
     // Zero vector
-    static Vector2 zero() {
-        return Vector2(0.0f, 0.0f);
+    static Vector2T zero() {
+        return Vector2T(T(0), T(0));
     }
 
     // Unit vectors
-    static Vector2 right() {
-        return Vector2(1.0f, 0.0f);
+    static Vector2T right() {
+        return Vector2T(T(1), T(0));
     }
 
-    static Vector2 up() {
-        return Vector2(0.0f, 1.0f);
+    static Vector2T up() {
+        return Vector2T(T(0), T(1));
     }
 
-    static Vector2 one() {
-        return Vector2(1.0f, 1.0f);
+    static Vector2T one() {
+        return Vector2T(T(1), T(1));
     }
 };
+
+using Vector2 = Vector2T<Scalar>;
@@ -0,0 +1,158 @@
+#include "displaylib_16/ili9341.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+void ILI9341_TFT::SetupScreenSize(uint16_t width, uint16_t height) {
+    width_ = width;
+    height_ = height;
+    pixels_.assign((size_t)width * height, C_BLACK);
+}
+
+bool ILI9341_TFT::openWindow(int32_t& x, int32_t& y, int32_t& w, int32_t& h) {
+    if (w <= 0 || h <= 0) return false;
+
+    // The panel receives the whole window even where it runs off screen
+    windowCount_++;
+    bytesSent_ += WINDOW_SETUP_BYTES + (uint64_t)w * h * 2;
+    pixelsWritten_ += (uint64_t)w * h;
+
+    if (x >= width_ || y >= height_ || x + w <= 0 || y + h <= 0) return false;
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > width_) w = width_ - x;
+    if (y + h > height_) h = height_ - y;
+    return true;
+}
+
+void ILI9341_TFT::fillScreen(uint16_t color) {
+    fillRect(0, 0, width_, height_, color);
+}
+
+void ILI9341_TFT::fillRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
+    int32_t cx = x, cy = y, cw = w, ch = h;
+    if (!openWindow(cx, cy, cw, ch)) return;
+
+    for (int32_t row = cy; row < cy + ch; row++) {
+        uint16_t* line = &pixels_[(size_t)row * width_];
+        for (int32_t col = cx; col < cx + cw; col++) {
+            line[col] = color;
+        }
+    }
+}
+
+void ILI9341_TFT::drawPixel(uint16_t x, uint16_t y, uint16_t color) {
+    fillRect(x, y, 1, 1, color);
+}
+
+void ILI9341_TFT::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    // Bresenham, one window per pixel like the library's generic path
+    int16_t dx = std::abs(x1 - x0);
+    int16_t dy = -std::abs(y1 - y0);
+    int16_t sx = x0 < x1 ? 1 : -1;
+    int16_t sy = y0 < y1 ? 1 : -1;
+    int16_t err = dx + dy;
+
+    while (true) {
+        if (x0 >= 0 && y0 >= 0) drawPixel(x0, y0, color);
+        if (x0 == x1 && y0 == y1) break;
+        int16_t e2 = 2 * err;
+        if (e2 >= dy) { err += dy; x0 += sx; }
+        if (e2 <= dx) { err += dx; y0 += sy; }
+    }
+}
+
+void ILI9341_TFT::drawRectWH(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
+    fillRect(x, y, w, 1, color);
+    fillRect(x, y + h - 1, w, 1, color);
+    fillRect(x, y, 1, h, color);
+    fillRect(x + w - 1, y, 1, h, color);
+}
+
+rdlib::Return_Codes_e ILI9341_TFT::drawBitmap16Data(uint16_t x, uint16_t y, uint8_t* data,
+                                                    uint16_t w, uint16_t h) {
+    if (x >= width_ || y >= height_) return rdlib::BitmapScreenBounds;
+
+    int32_t cx = x, cy = y, cw = w, ch = h;
+    if (!openWindow(cx, cy, cw, ch)) return rdlib::Success;
+
+    // Big-endian RGB565, rows w pixels apart
+    for (int32_t row = 0; row < ch; row++) {
+        const uint8_t* src = data + (size_t)row * w * 2;
+        uint16_t* dst = &pixels_[(size_t)(cy + row) * width_ + cx];
+        for (int32_t col = 0; col < cw; col++) {
+            dst[col] = (uint16_t)((src[col * 2] << 8) | src[col * 2 + 1]);
+        }
+    }
+    return rdlib::Success;
+}
+
+void ILI9341_TFT::setCursor(int16_t x, int16_t y) {
+    cursorX_ = x;
+    cursorY_ = y;
+}
+
+void ILI9341_TFT::setTextColor(uint16_t color, uint16_t background) {
+    textColor_ = color;
+    textBackground_ = background;
+}
+
+size_t ILI9341_TFT::print(const char* text) {
+    // 6x8 cells: background cell, with a 5x7 block for visible characters
+    size_t count = 0;
+    for (; *text; text++, count++) {
+        fillRect(cursorX_, cursorY_, 6, 8, textBackground_);
+        if (*text != ' ') {
+            fillRect(cursorX_, cursorY_, 5, 7, textColor_);
+        }
+        cursorX_ += 6;
+    }
+    return count;
+}
+
+uint16_t ILI9341_TFT::getPixel(uint16_t x, uint16_t y) const {
+    if (x >= width_ || y >= height_) return 0;
+    return pixels_[(size_t)y * width_ + x];
+}
+
+void ILI9341_TFT::setScrollArea(uint16_t top, uint16_t height) {
+    scrollTop_ = top;
+    scrollHeight_ = height;
+    scrollStart_ = top;
+    bytesSent_ += 7;
+}
+
+void ILI9341_TFT::setScrollStart(uint16_t line) {
+    scrollStart_ = line;
+    bytesSent_ += 3;
+}
+
+uint16_t ILI9341_TFT::getVisiblePixel(uint16_t x, uint16_t y) const {
+    if (scrollHeight_ > 0 && y >= scrollTop_ && y < scrollTop_ + scrollHeight_) {
+        y = scrollTop_ + (scrollStart_ - scrollTop_ + y - scrollTop_) % scrollHeight_;
+    }
+    return getPixel(x, y);
+}
+
+void ILI9341_TFT::resetCounters() {
+    bytesSent_ = 0;
+    windowCount_ = 0;
+    pixelsWritten_ = 0;
+}
+
+bool ILI9341_TFT::writePpm(const char* path) const {
+    FILE* file = std::fopen(path, "wb");
+    if (!file) return false;
+
+    std::fprintf(file, "P6\n%u %u\n255\n", width_, height_);
+    for (uint32_t i = 0; i < pixels_.size(); i++) {
+        uint16_t color = getVisiblePixel(i % width_, i / width_);
+        uint8_t rgb[3] = {
+            (uint8_t)(((color >> 11) & 0x1F) * 255 / 31),
+            (uint8_t)(((color >> 5) & 0x3F) * 255 / 63),
+            (uint8_t)((color & 0x1F) * 255 / 31),
+        };
+        std::fwrite(rgb, 1, sizeof(rgb), file);
+    }
+    return std::fclose(file) == 0;
+}
@@ -0,0 +1,69 @@
+// Host implementations of the Pico SDK calls pico_game uses
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const Clock::time_point bootTime = Clock::now();
+
+// Time skipped by sleeps, so pacing doesn't slow headless runs down
+std::atomic<uint64_t> sleptUs{0};
+
+std::thread core1;
+
+}
+
+uint64_t time_us_64(void) {
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - bootTime);
+    return (uint64_t)elapsed.count() + sleptUs.load(std::memory_order_relaxed);
+}
+
+uint32_t time_us_32(void) {
+    return (uint32_t)time_us_64();
+}
+
+absolute_time_t get_absolute_time(void) {
+    return time_us_64();
+}
+
+absolute_time_t from_us_since_boot(uint64_t us) {
+    return us;
+}
+
+uint32_t to_ms_since_boot(absolute_time_t t) {
+    return (uint32_t)(t / 1000);
+}
+
+void sleep_us(uint64_t us) {
+    sleptUs.fetch_add(us, std::memory_order_relaxed);
+}
+
+void sleep_ms(uint32_t ms) {
+    sleep_us((uint64_t)ms * 1000);
+}
+
+void sleep_until(absolute_time_t t) {
+    uint64_t now = time_us_64();
+    if (t > now) {
+        sleep_us(t - now);
+    }
+}
+
+bool stdio_init_all(void) {
+    return true;
+}
+
+void multicore_launch_core1(void (*entry)(void)) {
+    core1 = std::thread(entry);
+}
+
+void multicore_reset_core1(void) {
+    if (core1.joinable()) {
+        core1.join();
+    }
+}
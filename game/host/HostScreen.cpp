@@ -0,0 +1,37 @@
+#include "Screen.hpp"
+
+// Framebuffer-backed Screen: no touch controller and no DMA queue, so the
+// Renderer sends every window directly
+Screen::Screen() : dmaReady_(false) {
+    display_.SetupScreenSize(WIDTH, HEIGHT);
+    display_.fillScreen(display_.C_BLACK);
+    display_.resetCounters();
+}
+
+ILI9341_TFT& Screen::display() {
+    return display_;
+}
+
+bool Screen::isDmaReady() const {
+    return dmaReady_;
+}
+
+bool Screen::isTouchPressed() const {
+    return false;
+}
+
+bool Screen::readTouch(uint16_t& x, uint16_t& y) {
+    return false;
+}
+
+void Screen::clear(uint16_t color) {
+    display().fillScreen(color);
+}
+
+void Screen::setScrollArea(uint16_t top, uint16_t height) {
+    display_.setScrollArea(top, height);
+}
+
+void Screen::setScrollStart(uint16_t line) {
+    display_.setScrollStart(line);
+}
@@ -0,0 +1,365 @@
+// Headless benchmark: runs a few bouncing-sprite scenes through each
+// RenderMode on the simulated display and reports frame rate, SPI traffic
+// and broadphase work.
+//
+//   game_bench [--frames N] [--ppm prefix] [--check limits]
+//
+// Frame rate is host wall-clock time with frame pacing skipped (sleeps only
+// advance the virtual clock), so it measures engine CPU cost, not panel
+// speed. Bytes and windows are what the real driver would have sent.
+//
+// Bytes, windows and pairs per frame are deterministic under the virtual
+// clock. --check compares them with a limits file (see bench_limits.txt),
+// which also sets the frame count, and exits nonzero if any scene exceeds
+// its limits or has none.
+#include "Game.hpp"
+#include "Sprite.hpp"
+#include "Screen.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr uint16_t BALL_SIZE = 12;
+constexpr uint16_t SPARK_SIZE = 6;
+
+// Round sprite in big-endian RGB565 with a black (transparent) surround
+template <uint16_t SIZE>
+struct BallBitmap {
+    uint8_t data[SIZE * SIZE * 2];
+
+    explicit BallBitmap(uint16_t color) {
+        int32_t r = SIZE / 2;
+        for (int32_t y = 0; y < SIZE; y++) {
+            for (int32_t x = 0; x < SIZE; x++) {
+                int32_t dx = 2 * x + 1 - SIZE, dy = 2 * y + 1 - SIZE;
+                uint16_t c = dx * dx + dy * dy <= 4 * r * r ? color : 0x0000;
+                data[(y * SIZE + x) * 2] = c >> 8;
+                data[(y * SIZE + x) * 2 + 1] = c & 0xFF;
+            }
+        }
+    }
+};
+
+const BallBitmap<BALL_SIZE> ballBitmap(0xFFE0);
+const BallBitmap<SPARK_SIZE> sparkBitmap(0xF81F);
+
+constexpr uint8_t TILE_SIZE = 16;
+constexpr uint16_t TILE_COUNT = 4;
+constexpr uint16_t LEVEL_WIDTH = Screen::WIDTH / TILE_SIZE;
+constexpr uint16_t LEVEL_HEIGHT = 256;
+
+// Four shaded tiles and a level of them far taller than the screen
+struct TileAssets {
+    uint8_t pixels[TILE_COUNT * TILE_SIZE * TILE_SIZE * 2];
+    uint8_t level[LEVEL_WIDTH * LEVEL_HEIGHT];
+
+    TileAssets() {
+        const uint16_t colors[TILE_COUNT] = {0x0200, 0x0320, 0x4208, 0x8400};
+        for (uint16_t t = 0; t < TILE_COUNT; t++) {
+            for (uint16_t i = 0; i < TILE_SIZE * TILE_SIZE; i++) {
+                bool edge = i % TILE_SIZE == 0 || i < TILE_SIZE;
+                uint16_t c = edge ? colors[t] + 0x0841 : colors[t];
+                pixels[(t * TILE_SIZE * TILE_SIZE + i) * 2] = c >> 8;
+                pixels[(t * TILE_SIZE * TILE_SIZE + i) * 2 + 1] = c & 0xFF;
+            }
+        }
+        for (uint32_t i = 0; i < sizeof(level); i++) {
+            level[i] = (i * 7 + i / LEVEL_WIDTH * 3) % TILE_COUNT;
+        }
+    }
+};
+
+const TileAssets tileAssets;
+
+// Sprite moving at a constant speed and bouncing off the edges of the
+// visible part of the world
+class Bouncer : public Sprite {
+public:
+    Bouncer(const Game& game, const uint8_t* bitmap, uint16_t size,
+            const Vector2& pos, const Vector2& vel)
+        : Sprite(bitmap, size, size, pos), game_(game), size_(size) {
+        setVelocity(vel);
+    }
+
+    void update(float deltaTime) override {
+        Sprite::update(deltaTime);
+        Rect view = game_.getWorldView();
+        if ((position.x < view.x0 && velocity.x < 0) ||
+            (position.x > view.x1 - size_ && velocity.x > 0)) {
+            velocity.x = -velocity.x;
+        }
+        if ((position.y < view.y0 && velocity.y < 0) ||
+            (position.y > view.y1 - size_ && velocity.y > 0)) {
+            velocity.y = -velocity.y;
+        }
+    }
+
+private:
+    const Game& game_;
+    uint16_t size_;
+};
+
+struct SceneConfig {
+    const char* name;
+    uint16_t objects;
+    const uint8_t* bitmap;
+    uint16_t size;
+    int16_t scrollSpeed;  // Rows per frame on a hardware-scrolled playfield, 0 for none
+    bool tiles;           // Tile map background
+};
+
+struct SceneResult {
+    double fps = 0;
+    uint64_t bytes = 0;
+    uint64_t windows = 0;
+    uint64_t candidatePairs = 0;
+    uint64_t bruteForcePairs = 0;
+    uint64_t collisions = 0;
+};
+
+class BenchGame : public Game {
+public:
+    BenchGame(Screen& scr, const SceneConfig& config, uint32_t frames)
+        : Game(scr), config_(config), frames_(frames),
+          tileMap_(TileSet{tileAssets.pixels, TILE_COUNT, TILE_SIZE}, tileAssets.level,
+                   LEVEL_WIDTH, LEVEL_HEIGHT, Screen::WIDTH, Screen::HEIGHT) {}
+
+    const SceneResult& getResult() const { return result_; }
+
+    void onInit() override {
+        reservePool<Bouncer>(config_.objects);
+        if (config_.scrollSpeed != 0) {
+            // Start at the bottom of the level and fly up it
+            setScrollY(LEVEL_HEIGHT * TILE_SIZE - Screen::HEIGHT);
+            enableScrolling(0, Screen::HEIGHT);
+        }
+        if (config_.tiles) {
+            setTileMap(&tileMap_);
+        }
+
+        // Deterministic spread of positions and speeds
+        uint32_t seed = 12345;
+        auto next = [&seed](uint32_t range) {
+            seed = seed * 1103515245 + 12345;
+            return (int32_t)((seed >> 16) % range);
+        };
+        for (uint16_t i = 0; i < config_.objects; i++) {
+            Vector2 pos(next(Screen::WIDTH - config_.size),
+                        getScrollY() + next(Screen::HEIGHT - config_.size));
+            Vector2 vel(next(241) - 120, next(241) - 120);
+            spawn<Bouncer>(*this, config_.bitmap, config_.size, pos, vel);
+        }
+    }
+
+    void onUpdate(float deltaTime) override {
+        // Sprites ride along with the window, like a shooter's player and
+        // bullets, while the ground scrolls past
+        if (isScrolling()) {
+            setScrollY(getScrollY() - config_.scrollSpeed);
+            for (size_t i = 0; i < getGameObjectCount(); i++) {
+                GameObject* obj = getGameObjectAt(i);
+                obj->translate(Vector2(0, -config_.scrollSpeed));
+            }
+        }
+
+        // Skip the first frame's full repaint so it doesn't skew traffic
+        if (getFrameCount() == 1) {
+            getDisplay().resetCounters();
+            start_ = std::chrono::steady_clock::now();
+        }
+        if (getFrameCount() > 1) {
+            const CollisionStats& stats = getCollisionStats();
+            result_.candidatePairs += stats.candidatePairs;
+            result_.bruteForcePairs += stats.bruteForcePairs();
+            result_.collisions += stats.collisions;
+        }
+        if (getFrameCount() == frames_ + 1) {
+            auto elapsed = std::chrono::steady_clock::now() - start_;
+            result_.fps = frames_ / std::chrono::duration<double>(elapsed).count();
+            result_.bytes = getDisplay().getBytesSent();
+            result_.windows = getDisplay().getWindowCount();
+            stop();
+        }
+    }
+
+    // Ground markings every STRIPE_SPACING world rows, so scrolling shows
+    void onRenderBackground(const Rect& area) override {
+        if (config_.scrollSpeed == 0 || config_.tiles) return;
+
+        int16_t first = area.y0 - ((area.y0 % STRIPE_SPACING) + STRIPE_SPACING) % STRIPE_SPACING;
+        for (int16_t y = first; y < area.y1; y += STRIPE_SPACING) {
+            getRenderer().fillRect(area.x0, y, area.width(), 2, 0x4208);
+        }
+    }
+
+private:
+    static constexpr int16_t STRIPE_SPACING = 24;
+
+    SceneConfig config_;
+    uint32_t frames_;
+    TileMap tileMap_;
+    SceneResult result_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+const char* modeName(RenderMode mode) {
+    switch (mode) {
+        case RenderMode::FullClear: return "full";
+        case RenderMode::DirtyRects: return "dirty";
+        case RenderMode::Strips: return "strips";
+    }
+    return "?";
+}
+
+// Per-frame ceilings for one scene and mode
+struct SceneLimit {
+    std::string scene;
+    std::string mode;
+    unsigned long long bytes;
+    unsigned long long windows;
+    unsigned long long pairs;
+};
+
+// "frames N" sets the frame count; other lines are
+// "scene mode bytes/fr wins/fr pairs/fr". '#' starts a comment.
+bool loadLimits(const char* path, uint32_t& frames, std::vector<SceneLimit>& limits) {
+    FILE* file = std::fopen(path, "r");
+    if (!file) {
+        std::fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+
+    char line[160];
+    unsigned lineNumber = 0;
+    bool ok = true;
+    while (std::fgets(line, sizeof(line), file)) {
+        lineNumber++;
+        if (char* comment = std::strchr(line, '#')) *comment = '\0';
+
+        char scene[32], mode[16];
+        unsigned long count;
+        SceneLimit limit;
+        if (std::sscanf(line, " frames %lu", &count) == 1) {
+            frames = (uint32_t)count;
+        } else if (std::sscanf(line, " %31s %15s %llu %llu %llu", scene, mode,
+                               &limit.bytes, &limit.windows, &limit.pairs) == 5) {
+            limit.scene = scene;
+            limit.mode = mode;
+            limits.push_back(limit);
+        } else if (std::strspn(line, " \t\r\n") != std::strlen(line)) {
+            std::fprintf(stderr, "%s:%u: malformed line\n", path, lineNumber);
+            ok = false;
+        }
+    }
+    std::fclose(file);
+    return ok;
+}
+
+const SceneLimit* findLimit(const std::vector<SceneLimit>& limits, const char* scene, const char* mode) {
+    for (const SceneLimit& limit : limits) {
+        if (limit.scene == scene && limit.mode == mode) return &limit;
+    }
+    return nullptr;
+}
+
+// Report every measure over its limit; true if all are within
+bool checkLimit(const SceneLimit* limit, const char* scene, const char* mode,
+                unsigned long long bytes, unsigned long long windows, unsigned long long pairs) {
+    if (!limit) {
+        std::fprintf(stderr, "FAIL %s %s: no limits\n", scene, mode);
+        return false;
+    }
+
+    bool ok = true;
+    auto check = [&](const char* name, unsigned long long value, unsigned long long max) {
+        if (value > max) {
+            std::fprintf(stderr, "FAIL %s %s: %s %llu > %llu\n", scene, mode, name, value, max);
+            ok = false;
+        }
+    };
+    check("bytes/fr", bytes, limit->bytes);
+    check("wins/fr", windows, limit->windows);
+    check("pairs/fr", pairs, limit->pairs);
+    return ok;
+}
+
+}
+
+int main(int argc, char** argv) {
+    uint32_t frames = 600;
+    const char* ppmPrefix = nullptr;
+    const char* limitsPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--frames") && i + 1 < argc) {
+            frames = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        } else if (!std::strcmp(argv[i], "--ppm") && i + 1 < argc) {
+            ppmPrefix = argv[++i];
+        } else if (!std::strcmp(argv[i], "--check") && i + 1 < argc) {
+            limitsPath = argv[++i];
+        } else {
+            std::fprintf(stderr, "usage: %s [--frames N] [--ppm prefix] [--check limits]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // The limits were measured over a set number of frames
+    std::vector<SceneLimit> limits;
+    if (limitsPath && !loadLimits(limitsPath, frames, limits)) {
+        return 1;
+    }
+    if (frames == 0) frames = 1;
+    bool withinLimits = true;
+
+    const SceneConfig scenes[] = {
+        {"balls-16", 16, ballBitmap.data, BALL_SIZE, 0, false},
+        {"sparks-200", 200, sparkBitmap.data, SPARK_SIZE, 0, false},
+        {"scroll-16", 16, ballBitmap.data, BALL_SIZE, 2, false},
+        {"tiles-16", 16, ballBitmap.data, BALL_SIZE, 0, true},
+        {"tscroll-16", 16, ballBitmap.data, BALL_SIZE, 2, true},
+    };
+    const RenderMode modes[] = {RenderMode::FullClear, RenderMode::DirtyRects, RenderMode::Strips};
+
+    std::printf("%-11s %-7s %10s %10s %9s %10s %10s\n",
+                "scene", "mode", "fps", "bytes/fr", "wins/fr", "pairs/fr", "brute/fr");
+
+    for (const SceneConfig& scene : scenes) {
+        for (RenderMode mode : modes) {
+            // Hardware scrolling maps world rows in frame memory, which
+            // strip composition doesn't do
+            if (scene.scrollSpeed != 0 && mode == RenderMode::Strips) continue;
+
+            Screen screen;
+            BenchGame game(screen, scene, frames);
+            game.setRenderMode(mode);
+            game.run();
+
+            const SceneResult& r = game.getResult();
+            unsigned long long bytes = r.bytes / frames;
+            unsigned long long windows = r.windows / frames;
+            unsigned long long pairs = r.candidatePairs / frames;
+            std::printf("%-11s %-7s %10.0f %10llu %9llu %10llu %10llu\n",
+                        scene.name, modeName(mode), r.fps, bytes, windows, pairs,
+                        (unsigned long long)(r.bruteForcePairs / frames));
+
+            if (limitsPath &&
+                !checkLimit(findLimit(limits, scene.name, modeName(mode)),
+                            scene.name, modeName(mode), bytes, windows, pairs)) {
+                withinLimits = false;
+            }
+
+            if (ppmPrefix) {
+                std::string path = std::string(ppmPrefix) + "-" + scene.name + "-" + modeName(mode) + ".ppm";
+                if (!screen.display().writePpm(path.c_str())) {
+                    std::fprintf(stderr, "failed to write %s\n", path.c_str());
+                }
+            }
+        }
+    }
+    return withinLimits ? 0 : 1;
+}
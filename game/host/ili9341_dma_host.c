@@ -0,0 +1,52 @@
+/**
+ * @file ili9341_dma_host.c
+ * @brief Host build of the display DMA queue API: never ready
+ *
+ * display_dma_init() fails, so the Renderer draws through the
+ * framebuffer display directly; fences are always reached.
+ */
+
+#include "ili9341_dma.h"
+
+bool display_dma_init(void* spi_instance, uint8_t dc, uint8_t cs) {
+    return false;
+}
+
+void display_dma_deinit(void) {
+}
+
+bool display_dma_is_ready(void) {
+    return false;
+}
+
+display_dma_fence_t display_dma_fill_rect(uint16_t x, uint16_t y,
+                                          uint16_t width, uint16_t height, uint16_t color) {
+    return 0;
+}
+
+display_dma_fence_t display_dma_blit(uint16_t x, uint16_t y,
+                                     uint16_t width, uint16_t height, const uint8_t* data) {
+    return 0;
+}
+
+display_dma_fence_t display_dma_command(uint8_t cmd, const uint8_t* params, uint8_t count) {
+    return 0;
+}
+
+display_dma_fence_t display_dma_fence(void) {
+    return 0;
+}
+
+bool display_dma_fence_reached(display_dma_fence_t fence) {
+    return true;
+}
+
+void display_dma_wait(display_dma_fence_t fence) {
+}
+
+void display_dma_wait_idle(void) {
+}
+
+uint32_t display_dma_pending(void) {
+    return 0;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace rdlib {
+enum Return_Codes_e {
+    Success = 0,
+    BitmapScreenBounds = 1
+};
+}
+
+// Host stand-in for displaylib_16's ILI9341_TFT.
+//
+// Draws into a software framebuffer and counts the SPI traffic the real
+// driver would generate: every call that sets an address window adds one
+// CASET/PASET/RAMWR setup (11 bytes) plus 2 bytes per pixel. Only the calls
+// pico_game uses are provided. Text is drawn as solid cells in the text
+// color (no glyphs), which is enough to see layout in a dump.
+class ILI9341_TFT {
+public:
+    static constexpr uint16_t C_BLACK = 0x0000;
+    static constexpr uint16_t C_WHITE = 0xFFFF;
+    static constexpr uint16_t C_RED = 0xF800;
+    static constexpr uint16_t C_GREEN = 0x07E0;
+    static constexpr uint16_t C_BLUE = 0x001F;
+    static constexpr uint16_t C_YELLOW = 0xFFE0;
+
+    // Bytes to set one address window, as in Renderer::WINDOW_SETUP_BYTES
+    static constexpr uint32_t WINDOW_SETUP_BYTES = 11;
+
+    // Setup calls only record the size
+    void SetupGPIO(int8_t rst, int8_t dc, int8_t cs, int8_t sclk, int8_t mosi, int8_t miso) {}
+    void SetupScreenSize(uint16_t width, uint16_t height);
+    void SetupSPI(uint32_t baudrate, void* spi) {}
+    void ILI9341Initialize() {}
+
+    void fillScreen(uint16_t color);
+    void fillRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
+    void drawPixel(uint16_t x, uint16_t y, uint16_t color);
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+    void drawRectWH(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
+    rdlib::Return_Codes_e drawBitmap16Data(uint16_t x, uint16_t y, uint8_t* data,
+                                           uint16_t w, uint16_t h);
+
+    void setCursor(int16_t x, int16_t y);
+    void setTextColor(uint16_t color, uint16_t background);
+    void setTextWrap(bool wrap) {}
+    size_t print(const char* text);
+
+    uint16_t getWidth() const { return width_; }
+    uint16_t getHeight() const { return height_; }
+
+    // ===== Host-only =====
+
+    // Vertical scroll registers (VSCRDEF/VSCRSADD), each counted as a
+    // command with its parameter bytes
+    void setScrollArea(uint16_t top, uint16_t height);
+    void setScrollStart(uint16_t line);
+
+    // Pixel in frame memory, and the pixel the panel shows there after
+    // vertical scrolling
+    uint16_t getPixel(uint16_t x, uint16_t y) const;
+    uint16_t getVisiblePixel(uint16_t x, uint16_t y) const;
+    const std::vector<uint16_t>& getFramebuffer() const { return pixels_; }
+
+    // Traffic since the last resetCounters()
+    uint64_t getBytesSent() const { return bytesSent_; }
+    uint64_t getWindowCount() const { return windowCount_; }
+    uint64_t getPixelsWritten() const { return pixelsWritten_; }
+    void resetCounters();
+
+    // Write what the panel shows as a binary PPM (P6); false on I/O error
+    bool writePpm(const char* path) const;
+
+private:
+    uint16_t width_ = 0;
+    uint16_t height_ = 0;
+    std::vector<uint16_t> pixels_;
+
+    int16_t cursorX_ = 0;
+    int16_t cursorY_ = 0;
+    uint16_t textColor_ = C_WHITE;
+    uint16_t textBackground_ = C_BLACK;
+
+    uint16_t scrollTop_ = 0;
+    uint16_t scrollHeight_ = 0;
+    uint16_t scrollStart_ = 0;
+
+    uint64_t bytesSent_ = 0;
+    uint64_t windowCount_ = 0;
+    uint64_t pixelsWritten_ = 0;
+
+    // Count a window of w x h pixels and return its clipped extent
+    bool openWindow(int32_t& x, int32_t& y, int32_t& w, int32_t& h);
+};
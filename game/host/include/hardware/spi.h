@@ -0,0 +1,14 @@
+/**
+ * @file spi.h
+ * @brief Host stand-in for hardware/spi.h (types only, no bus)
+ */
+
+#ifndef HOST_HARDWARE_SPI_H
+#define HOST_HARDWARE_SPI_H
+
+typedef struct spi_inst spi_inst_t;
+
+#define spi0 ((spi_inst_t*)0)
+#define spi1 ((spi_inst_t*)1)
+
+#endif /* HOST_HARDWARE_SPI_H */
@@ -0,0 +1,27 @@
+/**
+ * @file multicore.h
+ * @brief Host stand-in for pico/multicore.h: core1 is a thread
+ */
+
+#ifndef HOST_PICO_MULTICORE_H
+#define HOST_PICO_MULTICORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Run entry on a new thread
+ */
+void multicore_launch_core1(void (*entry)(void));
+
+/**
+ * @brief Join the core1 thread; its entry function must have returned
+ */
+void multicore_reset_core1(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_PICO_MULTICORE_H */
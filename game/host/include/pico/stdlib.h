@@ -0,0 +1,43 @@
+/**
+ * @file stdlib.h
+ * @brief Host stand-in for the Pico SDK's pico/stdlib.h
+ *
+ * Time comes from the host's steady clock. Sleeping does not block:
+ * it advances a virtual offset added to every timer read, so headless
+ * runs go as fast as the host allows while the game still sees
+ * real-time pacing.
+ */
+
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint64_t absolute_time_t;
+
+uint64_t time_us_64(void);
+uint32_t time_us_32(void);
+
+absolute_time_t get_absolute_time(void);
+absolute_time_t from_us_since_boot(uint64_t us);
+uint32_t to_ms_since_boot(absolute_time_t t);
+
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+void sleep_until(absolute_time_t t);
+
+bool stdio_init_all(void);
+
+#define tight_loop_contents() do {} while (0)
+#define __wfe() do {} while (0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_PICO_STDLIB_H */
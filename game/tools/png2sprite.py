@@ -0,0 +1,294 @@
+#!/usr/bin/env python3
+"""Convert a PNG into a sprite header for the game engine.
+
+Formats (see game/Bitmap.hpp):
+  rgb565    big-endian RGB565 bytes for Sprite(bitmap, w, h) / blitTransparent
+  indexed4  16-color palette + 4-bit indices for blitIndexed
+  indexed8  256-color palette + 8-bit indices for blitIndexed
+  rle       run-length encoded RGB565 rows for blitRle
+  masked    big-endian RGB565 bytes plus a 1-bit opacity mask for blitMasked
+
+Pixels with alpha < 128, or matching --key, are transparent. In rgb565 they
+become 0x0000 (the default color key) and opaque black is nudged to 0x0020
+so it stays visible. The other formats carry transparency separately and
+keep every color.
+
+Only the standard library is used: 8-bit grayscale, RGB, palette (1-8 bit),
+grayscale+alpha and RGBA non-interlaced PNGs are supported.
+
+Usage: png2sprite.py input.png NAME [--format rle] [--key FF00FF] [-o out.hpp]
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+
+PNG_SIGNATURE = b"\x89PNG\r\n\x1a\n"
+RLE_OPAQUE = 0x80
+RLE_MAX_RUN = 0x80
+
+
+def read_png(path):
+    """Return (width, height, rows of (r, g, b, a) tuples)."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if not data.startswith(PNG_SIGNATURE):
+        raise ValueError("not a PNG file")
+
+    pos = len(PNG_SIGNATURE)
+    idat = b""
+    palette = []
+    trns = b""
+    header = None
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            header = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b"tRNS":
+            trns = body
+        elif kind == b"IDAT":
+            idat += body
+        elif kind == b"IEND":
+            break
+
+    width, height, depth, color_type, _, _, interlace = header
+    if interlace:
+        raise ValueError("interlaced PNGs are not supported")
+    if color_type == 3:
+        if depth not in (1, 2, 4, 8):
+            raise ValueError("unsupported palette depth %d" % depth)
+    elif depth != 8:
+        raise ValueError("only 8-bit channels are supported")
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color_type]
+    bits_per_pixel = depth * channels
+    stride = (width * bits_per_pixel + 7) // 8
+    bpp = max(1, bits_per_pixel // 8)
+    raw = zlib.decompress(idat)
+
+    rows = []
+    prev = bytearray(stride)
+    for y in range(height):
+        offset = y * (stride + 1)
+        filter_type = raw[offset]
+        line = bytearray(raw[offset + 1:offset + 1 + stride])
+        unfilter(filter_type, line, prev, bpp)
+        rows.append([decode_pixel(line, x, color_type, depth, palette, trns)
+                     for x in range(width)])
+        prev = line
+    return width, height, rows
+
+
+def unfilter(filter_type, line, prev, bpp):
+    for i in range(len(line)):
+        left = line[i - bpp] if i >= bpp else 0
+        up = prev[i]
+        up_left = prev[i - bpp] if i >= bpp else 0
+        if filter_type == 1:
+            line[i] = (line[i] + left) & 0xFF
+        elif filter_type == 2:
+            line[i] = (line[i] + up) & 0xFF
+        elif filter_type == 3:
+            line[i] = (line[i] + (left + up) // 2) & 0xFF
+        elif filter_type == 4:
+            p = left + up - up_left
+            pa, pb, pc = abs(p - left), abs(p - up), abs(p - up_left)
+            pred = left if pa <= pb and pa <= pc else (up if pb <= pc else up_left)
+            line[i] = (line[i] + pred) & 0xFF
+
+
+def decode_pixel(line, x, color_type, depth, palette, trns):
+    if color_type == 3:
+        per_byte = 8 // depth
+        byte = line[x // per_byte]
+        shift = 8 - depth * (x % per_byte + 1)
+        index = (byte >> shift) & ((1 << depth) - 1)
+        r, g, b = palette[index]
+        a = trns[index] if index < len(trns) else 255
+        return (r, g, b, a)
+    if color_type == 0:
+        v = line[x]
+        return (v, v, v, 255)
+    if color_type == 2:
+        return tuple(line[x * 3:x * 3 + 3]) + (255,)
+    if color_type == 4:
+        v, a = line[x * 2:x * 2 + 2]
+        return (v, v, v, a)
+    return tuple(line[x * 4:x * 4 + 4])
+
+
+def to_rgb565(r, g, b):
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def to_pixels(rows, key):
+    """Rows of RGB565 values, None for transparent pixels."""
+    out = []
+    for row in rows:
+        line = []
+        for r, g, b, a in row:
+            if a < 128 or (key is not None and (r, g, b) == key):
+                line.append(None)
+            else:
+                line.append(to_rgb565(r, g, b))
+        out.append(line)
+    return out
+
+
+def hex_lines(values, fmt, per_line):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append("    " + ", ".join(fmt % v for v in values[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def emit_rgb565(name, width, height, pixels):
+    data = []
+    for line in pixels:
+        for p in line:
+            if p is None:
+                p = 0x0000
+            elif p == 0x0000:
+                p = 0x0020
+            data += [p >> 8, p & 0xFF]
+    return ("const uint8_t %s_SPRITE[] = {\n%s\n};\n\n"
+            "const int %s_WIDTH = %d;\nconst int %s_HEIGHT = %d;\n"
+            % (name, hex_lines(data, "0x%02x", 16), name, width, name, height))
+
+
+def emit_masked(name, width, height, pixels):
+    data = []
+    mask = []
+    for line in pixels:
+        bits = [0 if p is None else 1 for p in line]
+        bits += [0] * (-len(bits) % 8)
+        mask += [int("".join(map(str, bits[i:i + 8])), 2) for i in range(0, len(bits), 8)]
+        for p in line:
+            p = p or 0
+            data += [p >> 8, p & 0xFF]
+    return ("const uint8_t %s_SPRITE[] = {\n%s\n};\n\n"
+            "const uint8_t %s_MASK[] = {\n%s\n};\n\n"
+            "const MaskedBitmap %s_BITMAP = {\n"
+            "    %s_SPRITE, %s_MASK, %d, %d\n};\n\n"
+            "const int %s_WIDTH = %d;\nconst int %s_HEIGHT = %d;\n"
+            % (name, hex_lines(data, "0x%02x", 16),
+               name, hex_lines(mask, "0x%02x", 16),
+               name, name, name, width, height,
+               name, width, name, height))
+
+
+def emit_indexed(name, width, height, pixels, bits):
+    colors = sorted({p for line in pixels for p in line if p is not None})
+    has_transparent = any(p is None for line in pixels for p in line)
+    limit = (1 << bits) - (1 if has_transparent else 0)
+    if len(colors) > limit:
+        raise ValueError("%d colors do not fit a %d-bit palette" % (len(colors), bits))
+
+    lookup = {c: i for i, c in enumerate(colors)}
+    transparent = len(colors) if has_transparent else -1
+    palette = colors + ([0] if has_transparent else [])
+
+    indices = []
+    for line in pixels:
+        row = [transparent if p is None else lookup[p] for p in line]
+        if bits == 4:
+            if len(row) % 2:
+                row.append(0)
+            indices += [(row[i] << 4) | row[i + 1] for i in range(0, len(row), 2)]
+        else:
+            indices += row
+
+    # Palette entries are stored in wire byte order (byte-swapped RGB565)
+    wire = [((c >> 8) | (c << 8)) & 0xFFFF for c in palette]
+    return ("const uint16_t %s_PALETTE[] = {\n%s\n};\n\n"
+            "const uint8_t %s_INDICES[] = {\n%s\n};\n\n"
+            "const IndexedBitmap %s_BITMAP = {\n"
+            "    %s_INDICES, %s_PALETTE, %d, %d, %d, %d\n};\n\n"
+            "const int %s_WIDTH = %d;\nconst int %s_HEIGHT = %d;\n"
+            % (name, hex_lines(wire, "0x%04x", 8),
+               name, hex_lines(indices, "0x%02x", 16),
+               name, name, name, width, height, bits, transparent,
+               name, width, name, height))
+
+
+def emit_rle(name, width, height, pixels):
+    data = []
+    offsets = []
+    for line in pixels:
+        offsets.append(len(data))
+        x = 0
+        while x < width:
+            opaque = line[x] is not None
+            run = 1
+            while (x + run < width and run < RLE_MAX_RUN
+                   and (line[x + run] is not None) == opaque):
+                run += 1
+            if opaque:
+                data.append(RLE_OPAQUE | (run - 1))
+                for p in line[x:x + run]:
+                    data += [p >> 8, p & 0xFF]
+            else:
+                data.append(run - 1)
+            x += run
+
+    return ("const uint8_t %s_RLE[] = {\n%s\n};\n\n"
+            "const uint32_t %s_ROWS[] = {\n%s\n};\n\n"
+            "const RleBitmap %s_BITMAP = {\n"
+            "    %s_RLE, %s_ROWS, %d, %d\n};\n\n"
+            "const int %s_WIDTH = %d;\nconst int %s_HEIGHT = %d;\n"
+            % (name, hex_lines(data, "0x%02x", 16),
+               name, hex_lines(offsets, "%d", 12),
+               name, name, name, width, height,
+               name, width, name, height))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a PNG to a sprite header")
+    parser.add_argument("input")
+    parser.add_argument("name", help="C identifier prefix, e.g. PLAYER")
+    parser.add_argument("--format", choices=["rgb565", "indexed4", "indexed8", "rle", "masked"],
+                        default="rgb565")
+    parser.add_argument("--key", help="RRGGBB color treated as transparent")
+    parser.add_argument("-o", "--output", help="Header to write (default stdout)")
+    args = parser.parse_args()
+
+    key = None
+    if args.key:
+        value = int(args.key.lstrip("#"), 16)
+        key = ((value >> 16) & 0xFF, (value >> 8) & 0xFF, value & 0xFF)
+
+    width, height, rows = read_png(args.input)
+    pixels = to_pixels(rows, key)
+    name = args.name.upper()
+
+    if args.format == "rgb565":
+        body = emit_rgb565(name, width, height, pixels)
+    elif args.format == "rle":
+        body = emit_rle(name, width, height, pixels)
+    elif args.format == "masked":
+        body = emit_masked(name, width, height, pixels)
+    else:
+        body = emit_indexed(name, width, height, pixels, 4 if args.format == "indexed4" else 8)
+
+    includes = "#include <cstdint>\n"
+    if args.format != "rgb565":
+        includes += '#include "Bitmap.hpp"\n'
+    text = "#pragma once\n\n%s\n%s" % (includes, body)
+
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except ValueError as e:
+        sys.exit("png2sprite: %s" % e)
@@ -2,22 +2,88 @@
  * Copyright (c) 2021 Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
- * 
+ *
  */
 
 #include "pico/stdlib.h"
 #include "hardware/spi.h"
+#include "hardware/dma.h"
 
 #include "spi-board.h"
+#include "pico/spi-bulk.h"
+#include "pico/board-config.h"
+
+static int spi_dma_tx = -1;
+static int spi_dma_rx = -1;
+
+static spi_inst_t* spi_instance(const Spi_t *obj)
+{
+    return (obj->SpiId == 0) ? spi0 : spi1;
+}
+
+static void spi_claim_dma(void)
+{
+    if (SPI_BULK_DMA_MIN_BYTES == 0 || spi_dma_tx >= 0)
+    {
+        return;
+    }
+
+    int tx = dma_claim_unused_channel(false);
+    int rx = dma_claim_unused_channel(false);
+    if (tx < 0 || rx < 0)
+    {
+        // Not enough channels; stay on the blocking path
+        if (tx >= 0)
+        {
+            dma_channel_unclaim(tx);
+        }
+        if (rx >= 0)
+        {
+            dma_channel_unclaim(rx);
+        }
+        return;
+    }
+
+    spi_dma_tx = tx;
+    spi_dma_rx = rx;
+}
+
+static void spi_transfer_dma(spi_inst_t* spi, const uint8_t *outData, uint8_t *inData, uint16_t size)
+{
+    static const uint8_t zero = 0;
+    static uint8_t discard;
+
+    dma_channel_config config = dma_channel_get_default_config(spi_dma_tx);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+    channel_config_set_dreq(&config, spi_get_dreq(spi, true));
+    channel_config_set_read_increment(&config, outData != NULL);
+    channel_config_set_write_increment(&config, false);
+    dma_channel_configure(spi_dma_tx, &config, &spi_get_hw(spi)->dr,
+                          outData != NULL ? outData : &zero, size, false);
+
+    // The RX channel always runs so the FIFO is drained; its completion
+    // also means the last byte has been clocked out
+    config = dma_channel_get_default_config(spi_dma_rx);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+    channel_config_set_dreq(&config, spi_get_dreq(spi, false));
+    channel_config_set_read_increment(&config, false);
+    channel_config_set_write_increment(&config, inData != NULL);
+    dma_channel_configure(spi_dma_rx, &config, inData != NULL ? inData : &discard,
+                          &spi_get_hw(spi)->dr, size, false);
+
+    dma_start_channel_mask((1u << spi_dma_tx) | (1u << spi_dma_rx));
+    dma_channel_wait_for_finish_blocking(spi_dma_rx);
+}
 
 void SpiInit( Spi_t *obj, SpiId_t spiId, PinNames mosi, PinNames miso, PinNames sclk, PinNames nss )
 {
     obj->SpiId=spiId; //bnn
-    spi_init((spiId == 0) ? spi0 : spi1, 10 * 1000 * 1000);
-    spi_set_format((spiId == 0) ? spi0 : spi1, 8, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+    spi_init(spi_instance(obj), RADIO_SPI_FREQUENCY);
+    spi_set_format(spi_instance(obj), 8, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
     gpio_set_function(mosi, GPIO_FUNC_SPI);
     gpio_set_function(miso, GPIO_FUNC_SPI);
     gpio_set_function(sclk, GPIO_FUNC_SPI);
+    spi_claim_dma();
 }
 
 uint16_t SpiInOut( Spi_t *obj, uint16_t outData )
@@ -25,7 +91,55 @@ uint16_t SpiInOut( Spi_t *obj, uint16_t outData )
     const uint8_t outDataB = (outData & 0xff);
     uint8_t inDataB = 0x00;
 
-    spi_write_read_blocking((obj->SpiId == 0) ? spi0 : spi1, &outDataB, &inDataB, 1);
+    spi_write_read_blocking(spi_instance(obj), &outDataB, &inDataB, 1);
 
     return inDataB;
 }
+
+void SpiTransfer( Spi_t *obj, const uint8_t *outData, uint8_t *inData, uint16_t size )
+{
+    spi_inst_t* spi = spi_instance(obj);
+
+    if (size == 0)
+    {
+        return;
+    }
+
+    if (spi_dma_tx >= 0 && size >= SPI_BULK_DMA_MIN_BYTES)
+    {
+        spi_transfer_dma(spi, outData, inData, size);
+    }
+    else if (outData != NULL && inData != NULL)
+    {
+        spi_write_read_blocking(spi, outData, inData, size);
+    }
+    else if (outData != NULL)
+    {
+        spi_write_blocking(spi, outData, size);
+    }
+    else if (inData != NULL)
+    {
+        spi_read_blocking(spi, 0x00, inData, size);
+    }
+    else
+    {
+        // Clock out zeros and drop the replies
+        static const uint8_t zeros[16] = { 0 };
+        while (size > 0)
+        {
+            uint16_t chunk = (size < sizeof(zeros)) ? size : sizeof(zeros);
+            spi_write_blocking(spi, zeros, chunk);
+            size -= chunk;
+        }
+    }
+}
+
+void SpiOut( Spi_t *obj, const uint8_t *outData, uint16_t size )
+{
+    SpiTransfer(obj, outData, NULL, size);
+}
+
+void SpiIn( Spi_t *obj, uint8_t *inData, uint16_t size )
+{
+    SpiTransfer(obj, NULL, inData, size);
+}
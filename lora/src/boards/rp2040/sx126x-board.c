@@ -24,12 +24,15 @@
  * \author    Gregory Cristian ( Semtech )
  */
 #include <stdlib.h>
+#include "pico/stdlib.h"
 #include "utilities.h"
 #include "pico/board-config.h"
 #include "board.h"
 #include "delay.h"
 #include "radio.h"
 #include "sx126x-board.h"
+#include "pico/spi-bulk.h"
+#include "pico/sx126x-busy.h"
 
 #if defined( USE_RADIO_DEBUG )
 /*!
@@ -52,6 +55,52 @@ static void SX126xDbgPinRxWrite( uint8_t state );
  */
 static RadioOperatingModes_t OperatingMode;
 
+/*!
+ * \brief BUSY wait state: the command the radio is busy with, whether the
+ *        falling-edge interrupt is installed, and per-command statistics
+ */
+static uint8_t BusyCommand;
+static bool BusyIrqEnabled = false;
+static void ( *BusyYield )( void ) = NULL;
+static SX126xBusyStats_t BusyStats[SX126X_BUSY_STATS_COMMANDS];
+static uint8_t BusyStatsCount;
+
+static void SX126xOnBusyIrq( void* context )
+{
+    // Nothing to do: taking the interrupt wakes the core from WFE
+    ( void )context;
+}
+
+static void SX126xRecordBusyWait( uint8_t command, uint32_t us )
+{
+    SX126xBusyStats_t *stats = NULL;
+
+    for( uint8_t i = 0; i < BusyStatsCount; i++ )
+    {
+        if( BusyStats[i].Command == command )
+        {
+            stats = &BusyStats[i];
+            break;
+        }
+    }
+    if( stats == NULL )
+    {
+        if( BusyStatsCount == SX126X_BUSY_STATS_COMMANDS )
+        {
+            return;
+        }
+        stats = &BusyStats[BusyStatsCount++];
+        stats->Command = command;
+    }
+
+    stats->Waits++;
+    stats->TotalUs += us;
+    if( us > stats->MaxUs )
+    {
+        stats->MaxUs = us;
+    }
+}
+
 /*!
  * Antenna switch GPIO pins objects
  */
@@ -77,10 +126,14 @@ void SX126xIoInit( void )
 void SX126xIoIrqInit( DioIrqHandler dioIrq )
 {
     GpioSetInterrupt( &SX126x.DIO1, IRQ_RISING_EDGE, IRQ_HIGH_PRIORITY, dioIrq );
+    GpioSetInterrupt( &SX126x.BUSY, IRQ_FALLING_EDGE, IRQ_HIGH_PRIORITY, SX126xOnBusyIrq );
+    BusyIrqEnabled = true;
 }
 
 void SX126xIoDeInit( void )
 {
+    BusyIrqEnabled = false;
+    GpioRemoveInterrupt( &SX126x.BUSY );
     GpioInit( &SX126x.Spi.Nss, RADIO_NSS, PIN_OUTPUT, PIN_PUSH_PULL, PIN_NO_PULL, 1 );
     GpioInit( &SX126x.BUSY, RADIO_BUSY, PIN_INPUT, PIN_PUSH_PULL, PIN_NO_PULL, 0 );
     GpioInit( &SX126x.DIO1, RADIO_DIO_1, PIN_INPUT, PIN_PUSH_PULL, PIN_NO_PULL, 0 );
@@ -152,43 +205,102 @@ void SX126xReset( void )
 
 void SX126xWaitOnBusy( void )
 {
-    while( GpioRead( &SX126x.BUSY ) == 1 );
+    uint32_t start;
+
+    if( GpioRead( &SX126x.BUSY ) == 0 )
+    {
+        return;
+    }
+
+    start = time_us_32( );
+
+    // In thread mode the falling edge that ends the wait raises an
+    // interrupt, and taking it sets the event register, so an edge between
+    // the read and the WFE is not missed. Inside an interrupt handler (radio
+    // calls from a timer callback) the BUSY interrupt cannot preempt and
+    // would never wake the core, and the yield hook must not run, so spin.
+    if( __get_current_exception( ) != 0 )
+    {
+        while( GpioRead( &SX126x.BUSY ) == 1 );
+    }
+    else
+    {
+        while( GpioRead( &SX126x.BUSY ) == 1 )
+        {
+            if( BusyYield != NULL )
+            {
+                BusyYield( );
+            }
+            else if( BusyIrqEnabled )
+            {
+                __wfe( );
+            }
+        }
+    }
+
+    SX126xRecordBusyWait( BusyCommand, time_us_32( ) - start );
+}
+
+void SX126xSetBusyYield( void ( *yield )( void ) )
+{
+    BusyYield = yield;
+}
+
+uint8_t SX126xGetBusyStats( SX126xBusyStats_t *stats, uint8_t max )
+{
+    uint8_t count = ( BusyStatsCount < max ) ? BusyStatsCount : max;
+
+    for( uint8_t i = 0; i < count; i++ )
+    {
+        stats[i] = BusyStats[i];
+    }
+    return count;
+}
+
+void SX126xResetBusyStats( void )
+{
+    BusyStatsCount = 0;
+    memset1( ( uint8_t* )BusyStats, 0, sizeof( BusyStats ) );
 }
 
 void SX126xWakeup( void )
 {
+    uint8_t header[2] = { RADIO_GET_STATUS, 0x00 };
+
+    // Only the wake-up pulse is atomic; the wait for the chip to come out of
+    // sleep runs with interrupts enabled
     CRITICAL_SECTION_BEGIN( );
 
     GpioWrite( &SX126x.Spi.Nss, 0 );
 
-    SpiInOut( &SX126x.Spi, RADIO_GET_STATUS );
-    SpiInOut( &SX126x.Spi, 0x00 );
+    SpiOut( &SX126x.Spi, header, sizeof( header ) );
 
     GpioWrite( &SX126x.Spi.Nss, 1 );
 
+    BusyCommand = RADIO_GET_STATUS;
+
+    CRITICAL_SECTION_END( );
+
     // Wait for chip to be ready.
     SX126xWaitOnBusy( );
 
     // Update operating mode context variable
     SX126xSetOperatingMode( MODE_STDBY_RC );
-
-    CRITICAL_SECTION_END( );
 }
 
 void SX126xWriteCommand( RadioCommands_t command, uint8_t *buffer, uint16_t size )
 {
+    uint8_t opcode = ( uint8_t )command;
+
     SX126xCheckDeviceReady( );
 
     GpioWrite( &SX126x.Spi.Nss, 0 );
 
-    SpiInOut( &SX126x.Spi, ( uint8_t )command );
-
-    for( uint16_t i = 0; i < size; i++ )
-    {
-        SpiInOut( &SX126x.Spi, buffer[i] );
-    }
+    SpiOut( &SX126x.Spi, &opcode, 1 );
+    SpiOut( &SX126x.Spi, buffer, size );
 
     GpioWrite( &SX126x.Spi.Nss, 1 );
+    BusyCommand = ( uint8_t )command;
 
     if( command != RADIO_SET_SLEEP )
     {
@@ -198,42 +310,38 @@ void SX126xWriteCommand( RadioCommands_t command, uint8_t *buffer, uint16_t size
 
 uint8_t SX126xReadCommand( RadioCommands_t command, uint8_t *buffer, uint16_t size )
 {
-    uint8_t status = 0;
+    uint8_t header[2] = { ( uint8_t )command, 0x00 };
+    uint8_t reply[2];
 
     SX126xCheckDeviceReady( );
 
     GpioWrite( &SX126x.Spi.Nss, 0 );
 
-    SpiInOut( &SX126x.Spi, ( uint8_t )command );
-    status = SpiInOut( &SX126x.Spi, 0x00 );
-    for( uint16_t i = 0; i < size; i++ )
-    {
-        buffer[i] = SpiInOut( &SX126x.Spi, 0 );
-    }
+    // The status byte is clocked in while the NOP after the opcode goes out
+    SpiTransfer( &SX126x.Spi, header, reply, sizeof( header ) );
+    SpiIn( &SX126x.Spi, buffer, size );
 
     GpioWrite( &SX126x.Spi.Nss, 1 );
+    BusyCommand = ( uint8_t )command;
 
     SX126xWaitOnBusy( );
 
-    return status;
+    return reply[1];
 }
 
 void SX126xWriteRegisters( uint16_t address, uint8_t *buffer, uint16_t size )
 {
+    uint8_t header[3] = { RADIO_WRITE_REGISTER, ( address & 0xFF00 ) >> 8, address & 0x00FF };
+
     SX126xCheckDeviceReady( );
 
     GpioWrite( &SX126x.Spi.Nss, 0 );
-    
-    SpiInOut( &SX126x.Spi, RADIO_WRITE_REGISTER );
-    SpiInOut( &SX126x.Spi, ( address & 0xFF00 ) >> 8 );
-    SpiInOut( &SX126x.Spi, address & 0x00FF );
-    
-    for( uint16_t i = 0; i < size; i++ )
-    {
-        SpiInOut( &SX126x.Spi, buffer[i] );
-    }
+
+    SpiOut( &SX126x.Spi, header, sizeof( header ) );
+    SpiOut( &SX126x.Spi, buffer, size );
 
     GpioWrite( &SX126x.Spi.Nss, 1 );
+    BusyCommand = RADIO_WRITE_REGISTER;
 
     SX126xWaitOnBusy( );
 }
@@ -245,19 +353,17 @@ void SX126xWriteRegister( uint16_t address, uint8_t value )
 
 void SX126xReadRegisters( uint16_t address, uint8_t *buffer, uint16_t size )
 {
+    uint8_t header[4] = { RADIO_READ_REGISTER, ( address & 0xFF00 ) >> 8, address & 0x00FF, 0x00 };
+
     SX126xCheckDeviceReady( );
 
     GpioWrite( &SX126x.Spi.Nss, 0 );
 
-    SpiInOut( &SX126x.Spi, RADIO_READ_REGISTER );
-    SpiInOut( &SX126x.Spi, ( address & 0xFF00 ) >> 8 );
-    SpiInOut( &SX126x.Spi, address & 0x00FF );
-    SpiInOut( &SX126x.Spi, 0 );
-    for( uint16_t i = 0; i < size; i++ )
-    {
-        buffer[i] = SpiInOut( &SX126x.Spi, 0 );
-    }
+    SpiOut( &SX126x.Spi, header, sizeof( header ) );
+    SpiIn( &SX126x.Spi, buffer, size );
+
     GpioWrite( &SX126x.Spi.Nss, 1 );
+    BusyCommand = RADIO_READ_REGISTER;
 
     SX126xWaitOnBusy( );
 }
@@ -271,35 +377,34 @@ uint8_t SX126xReadRegister( uint16_t address )
 
 void SX126xWriteBuffer( uint8_t offset, uint8_t *buffer, uint8_t size )
 {
+    uint8_t header[2] = { RADIO_WRITE_BUFFER, offset };
+
     SX126xCheckDeviceReady( );
 
     GpioWrite( &SX126x.Spi.Nss, 0 );
 
-    SpiInOut( &SX126x.Spi, RADIO_WRITE_BUFFER );
-    SpiInOut( &SX126x.Spi, offset );
-    for( uint16_t i = 0; i < size; i++ )
-    {
-        SpiInOut( &SX126x.Spi, buffer[i] );
-    }
+    SpiOut( &SX126x.Spi, header, sizeof( header ) );
+    SpiOut( &SX126x.Spi, buffer, size );
+
     GpioWrite( &SX126x.Spi.Nss, 1 );
+    BusyCommand = RADIO_WRITE_BUFFER;
 
     SX126xWaitOnBusy( );
 }
 
 void SX126xReadBuffer( uint8_t offset, uint8_t *buffer, uint8_t size )
 {
+    uint8_t header[3] = { RADIO_READ_BUFFER, offset, 0x00 };
+
     SX126xCheckDeviceReady( );
 
     GpioWrite( &SX126x.Spi.Nss, 0 );
 
-    SpiInOut( &SX126x.Spi, RADIO_READ_BUFFER );
-    SpiInOut( &SX126x.Spi, offset );
-    SpiInOut( &SX126x.Spi, 0 );
-    for( uint16_t i = 0; i < size; i++ )
-    {
-        buffer[i] = SpiInOut( &SX126x.Spi, 0 );
-    }
+    SpiOut( &SX126x.Spi, header, sizeof( header ) );
+    SpiIn( &SX126x.Spi, buffer, size );
+
     GpioWrite( &SX126x.Spi.Nss, 1 );
+    BusyCommand = RADIO_READ_BUFFER;
 
     SX126xWaitOnBusy( );
 }
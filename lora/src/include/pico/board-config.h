@@ -56,6 +56,13 @@ extern "C"
 #define RADIO_BUSY                                  12
 #define RADIO_DIO_1                                 10
 
+/*!
+ * Radio SPI clock [Hz]; the SX126x accepts up to 16 MHz
+ */
+#ifndef RADIO_SPI_FREQUENCY
+#define RADIO_SPI_FREQUENCY                         16000000
+#endif
+
 // #define RADIO_ANT_SWITCH_POWER                      22
 
 #ifdef __cplusplus
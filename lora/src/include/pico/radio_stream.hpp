@@ -1,9 +1,21 @@
 #ifndef PICO_RADIO_STREAM_HPP
 #define PICO_RADIO_STREAM_HPP
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 
+// Received packets waiting to be read; must be a power of two
+#ifndef RADIO_STREAM_RX_QUEUE_DEPTH
+#define RADIO_STREAM_RX_QUEUE_DEPTH 8
+#endif
+
+// Frames waiting to be transmitted, including the one on air; must be a
+// power of two
+#ifndef RADIO_STREAM_TX_QUEUE_DEPTH
+#define RADIO_STREAM_TX_QUEUE_DEPTH 4
+#endif
+
 class RadioStream {
 public:
     struct Config {
@@ -30,6 +42,30 @@ public:
         uint8_t* data;
         size_t max_length;
         size_t length;
+        int16_t rssi = 0;
+        int8_t snr = 0;
+        uint64_t timestamp_us = 0;
+    };
+
+    enum class TxStatus : uint8_t {
+        Sent,
+        Timeout,
+    };
+
+    // Called from poll() when a queued frame has been sent or timed out
+    using TxCallback = void (*)(TxStatus status, void* context);
+
+    static constexpr size_t kBufferSize = 255;
+    static constexpr size_t kRxQueueDepth = RADIO_STREAM_RX_QUEUE_DEPTH;
+    static constexpr size_t kTxQueueDepth = RADIO_STREAM_TX_QUEUE_DEPTH;
+
+    // A queued packet, borrowed in place with acquire()
+    struct RxPacket {
+        uint8_t data[kBufferSize];
+        uint8_t length;
+        int8_t snr;
+        int16_t rssi;
+        uint64_t timestamp_us;  // time_us_64() when the packet was taken off the radio
     };
 
     RadioStream();
@@ -37,13 +73,39 @@ public:
     bool init(const Config& config);
     void poll();
 
-    bool send(const uint8_t* data, size_t length);
+    // Queue a frame (truncated to kBufferSize); false if the queue is full.
+    // Frames go out back to back as each one completes, and the radio
+    // returns to RX once the queue drains. A frame sent while the queue is
+    // empty is loaded straight into the radio; later ones are copied into
+    // their slot. Call from the same context as poll(), which drives the
+    // radio for both.
+    bool send(const uint8_t* data, size_t length,
+              TxCallback callback = nullptr, void* context = nullptr);
+
+    // Re-arm RX; does nothing while frames are queued
     void start_rx();
 
+    // Packets are queued as they arrive and the radio keeps listening; when
+    // the queue is full new packets are dropped and counted as overflows.
+    // Packets that fail their CRC or header check are counted as errors.
     bool available() const;
+    size_t rx_pending() const;
+    uint32_t rx_overflows() const;
+    uint32_t rx_errors() const;
+
+    // Oldest queued packet, truncated to max_length; 0 if none
     size_t read(uint8_t* out, size_t max_length);
 
+    // Zero-copy access to the oldest queued packet, or nullptr if none. The
+    // slot stays out of the ring until release(), so the payload can be
+    // parsed or decrypted in place; acquiring again before then returns the
+    // same packet. A borrowed packet still occupies its slot.
+    RxPacket* acquire();
+    void release();
+
+    // True while any frame is queued or on air
     bool tx_busy() const;
+    size_t tx_pending() const;
     bool last_tx_timeout() const;
     int16_t last_rssi() const;
     int8_t last_snr() const;
@@ -53,6 +115,11 @@ public:
     RadioStream& operator<<(const char* text);
 
 private:
+    // Radio events. TxDone, RxDone and RxError come from Radio.IrqProcess()
+    // in poll(). TxTimeout can also come from the LoRaMac-node timer, which
+    // fires in the alarm-pool interrupt (rtc-board.c), so it only raises a
+    // flag that poll() acts on; the RX error handlers do the same. RX runs
+    // without a timer, so RxTimeout only reports header errors.
     static void on_tx_done();
     static void on_tx_timeout();
     static void on_rx_done(uint8_t* payload, uint16_t size, int16_t rssi, int8_t snr);
@@ -60,20 +127,52 @@ private:
     static void on_rx_error();
 
     void handle_rx_done(uint8_t* payload, uint16_t size, int16_t rssi, int8_t snr);
+    void start_tx(const uint8_t* data, uint8_t length);
+    void finish_tx(TxStatus status);
 
     static RadioStream* instance_;
 
     Config config_;
     bool initialized_ = false;
-    bool tx_busy_ = false;
     bool last_tx_timeout_ = false;
-    bool rx_ready_ = false;
     int16_t last_rssi_ = 0;
     int8_t last_snr_ = 0;
 
-    static constexpr size_t kBufferSize = 255;
-    uint8_t rx_buffer_[kBufferSize];
-    size_t rx_size_ = 0;
+    static_assert((kRxQueueDepth & (kRxQueueDepth - 1)) == 0,
+                  "RADIO_STREAM_RX_QUEUE_DEPTH must be a power of two");
+    static_assert((kTxQueueDepth & (kTxQueueDepth - 1)) == 0,
+                  "RADIO_STREAM_TX_QUEUE_DEPTH must be a power of two");
+
+    struct TxFrame {
+        uint8_t data[kBufferSize];
+        uint8_t length;
+        TxCallback callback;
+        void* context;
+    };
+
+    // The frame at tx_tail_ is on air; both ends are only touched from the
+    // poll() context
+    TxFrame tx_queue_[kTxQueueDepth];
+    uint32_t tx_head_ = 0;
+    uint32_t tx_tail_ = 0;
+
+    // Sequence (tx_tail_) of the frame last handed to the radio, and of the
+    // frame on air when the timeout fired
+    std::atomic<uint32_t> tx_on_air_{0};
+    std::atomic<uint32_t> tx_timeout_sequence_{0};
+
+    // Single-producer/single-consumer ring: rx_head_ is written only by the
+    // radio event path, rx_tail_ only by the reader, so no locking is needed
+    // even when poll() runs from an interrupt or the other core
+    RxPacket rx_queue_[kRxQueueDepth];
+    std::atomic<uint32_t> rx_head_{0};
+    std::atomic<uint32_t> rx_tail_{0};
+    std::atomic<uint32_t> rx_overflows_{0};
+    std::atomic<uint32_t> rx_errors_{0};
+
+    // Raised by the timeout and error handlers, cleared by poll()
+    std::atomic<bool> tx_timeout_pending_{false};
+    std::atomic<bool> rx_check_pending_{false};
 };
 
 #endif // PICO_RADIO_STREAM_HPP
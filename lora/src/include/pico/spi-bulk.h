@@ -0,0 +1,63 @@
+/*!
+ * \file      spi-bulk.h
+ *
+ * \brief     Multi-byte SPI transfers for the RP2040 board shim
+ *
+ * \remark    SpiInOut moves one byte per call; these move a whole buffer in
+ *            one transfer. Transfers of at least SPI_BULK_DMA_MIN_BYTES go
+ *            through a pair of DMA channels claimed in SpiInit, shorter ones
+ *            (and all of them if no channels are free) through the SDK's
+ *            blocking FIFO loops. Either way the call returns once the last
+ *            byte has been clocked.
+ */
+#ifndef __SPI_BULK_H__
+#define __SPI_BULK_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include "spi.h"
+
+/*!
+ * Smallest transfer handed to DMA; 0 disables the DMA path
+ */
+#ifndef SPI_BULK_DMA_MIN_BYTES
+#define SPI_BULK_DMA_MIN_BYTES                      32
+#endif
+
+/*!
+ * \brief Sends and receives a buffer
+ *
+ * \param [IN]  obj     SPI object
+ * \param [IN]  outData Bytes to send, or NULL to send zeros
+ * \param [OUT] inData  Received bytes, or NULL to discard them
+ * \param [IN]  size    Number of bytes
+ */
+void SpiTransfer( Spi_t *obj, const uint8_t *outData, uint8_t *inData, uint16_t size );
+
+/*!
+ * \brief Sends a buffer, discarding what is received
+ *
+ * \param [IN] obj     SPI object
+ * \param [IN] outData Bytes to send
+ * \param [IN] size    Number of bytes
+ */
+void SpiOut( Spi_t *obj, const uint8_t *outData, uint16_t size );
+
+/*!
+ * \brief Receives a buffer while sending zeros
+ *
+ * \param [IN]  obj    SPI object
+ * \param [OUT] inData Received bytes
+ * \param [IN]  size   Number of bytes
+ */
+void SpiIn( Spi_t *obj, uint8_t *inData, uint16_t size );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SPI_BULK_H__
@@ -0,0 +1,71 @@
+/*!
+ * \file      sx126x-busy.h
+ *
+ * \brief     SX126x BUSY line waiting and statistics for the RP2040 board
+ *
+ * \remark    After each command the SX126x holds BUSY high until it is ready
+ *            for the next one; calibration and mode changes take
+ *            milliseconds. Once SX126xIoIrqInit has run, SX126xWaitOnBusy
+ *            sleeps until a BUSY falling-edge interrupt instead of spinning,
+ *            with interrupts enabled, or calls a yield hook while it waits.
+ *            Waits inside an interrupt handler always spin.
+ *            Every wait that finds BUSY high is timed and charged to the
+ *            command that raised it.
+ */
+#ifndef __SX126X_BUSY_H__
+#define __SX126X_BUSY_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+/*!
+ * Distinct commands tracked; waits for further commands are not recorded
+ */
+#ifndef SX126X_BUSY_STATS_COMMANDS
+#define SX126X_BUSY_STATS_COMMANDS                  24
+#endif
+
+/*!
+ * BUSY wait statistics for one command opcode
+ */
+typedef struct
+{
+    uint8_t  Command;   //!< RadioCommands_t opcode
+    uint32_t Waits;     //!< Waits that found BUSY high
+    uint32_t MaxUs;     //!< Longest wait [us]
+    uint32_t TotalUs;   //!< Sum of all waits [us]
+}SX126xBusyStats_t;
+
+/*!
+ * \brief Sets a function called repeatedly while BUSY is high
+ *
+ * \remark Without a hook the core sleeps (WFE) until the BUSY interrupt.
+ *         The hook only runs in thread mode and must not access the radio.
+ *
+ * \param [IN] yield Hook, or NULL to sleep
+ */
+void SX126xSetBusyYield( void ( *yield )( void ) );
+
+/*!
+ * \brief Copies the per-command statistics
+ *
+ * \param [OUT] stats Destination
+ * \param [IN]  max   Entries available in stats
+ * \retval count      Entries written, in order of first use
+ */
+uint8_t SX126xGetBusyStats( SX126xBusyStats_t *stats, uint8_t max );
+
+/*!
+ * \brief Clears the per-command statistics
+ */
+void SX126xResetBusyStats( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SX126X_BUSY_H__
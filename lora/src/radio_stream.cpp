@@ -123,16 +123,43 @@ void RadioStream::poll()
     {
         Radio.IrqProcess();
     }
+
+    // Events deferred from interrupt context; a flag raised again between
+    // the load and the clear is the same event and is handled here
+    if (tx_timeout_pending_.load(std::memory_order_acquire))
+    {
+        tx_timeout_pending_.store(false, std::memory_order_relaxed);
+
+        // IrqProcess() may have finished that frame already; the timeout is
+        // then stale and must not end the next one
+        if (tx_busy() && tx_timeout_sequence_.load(std::memory_order_relaxed) == tx_tail_)
+        {
+            // The MCU timer fired, so the radio may still be transmitting
+            Radio.Standby();
+            finish_tx(TxStatus::Timeout);
+        }
+    }
+
+    // RX is continuous, so a bad packet normally leaves the radio
+    // listening; only re-arm if it has actually dropped out of RX
+    if (rx_check_pending_.load(std::memory_order_acquire))
+    {
+        rx_check_pending_.store(false, std::memory_order_relaxed);
+        if (!tx_busy() && Radio.GetStatus() != RF_RX_RUNNING)
+        {
+            start_rx();
+        }
+    }
 }
 
-bool RadioStream::send(const uint8_t* data, size_t length)
+bool RadioStream::send(const uint8_t* data, size_t length, TxCallback callback, void* context)
 {
-    if (!initialized_ || tx_busy_)
+    if (!initialized_ || data == nullptr || length == 0)
     {
         return false;
     }
 
-    if (length == 0)
+    if (tx_head_ - tx_tail_ >= kTxQueueDepth)
     {
         return false;
     }
@@ -142,46 +169,144 @@ bool RadioStream::send(const uint8_t* data, size_t length)
         length = kBufferSize;
     }
 
-    tx_busy_ = true;
-    last_tx_timeout_ = false;
+    bool idle = tx_head_ == tx_tail_;
+    TxFrame& frame = tx_queue_[tx_head_ & (kTxQueueDepth - 1)];
+    frame.length = static_cast<uint8_t>(length);
+    frame.callback = callback;
+    frame.context = context;
+    if (!idle)
+    {
+        memcpy(frame.data, data, length);
+    }
+    tx_head_++;
 
-    Radio.Send(const_cast<uint8_t*>(data), static_cast<uint8_t>(length));
+    if (idle)
+    {
+        // Radio.Send copies the payload into the radio before returning
+        start_tx(data, frame.length);
+    }
     return true;
 }
 
+void RadioStream::start_tx(const uint8_t* data, uint8_t length)
+{
+    // Always the frame at tx_tail_
+    tx_on_air_.store(tx_tail_, std::memory_order_relaxed);
+    Radio.Send(const_cast<uint8_t*>(data), length);
+}
+
+void RadioStream::finish_tx(TxStatus status)
+{
+    if (tx_head_ == tx_tail_)
+    {
+        return;
+    }
+
+    const TxFrame& done = tx_queue_[tx_tail_ & (kTxQueueDepth - 1)];
+    TxCallback callback = done.callback;
+    void* context = done.context;
+    tx_tail_++;
+    last_tx_timeout_ = status == TxStatus::Timeout;
+
+    if (tx_head_ != tx_tail_)
+    {
+        const TxFrame& next = tx_queue_[tx_tail_ & (kTxQueueDepth - 1)];
+        start_tx(next.data, next.length);
+    }
+    else
+    {
+        Radio.Rx(0);
+    }
+
+    // Last, so the callback can queue more frames
+    if (callback != nullptr)
+    {
+        callback(status, context);
+    }
+}
+
 void RadioStream::start_rx()
 {
-    if (!initialized_)
+    // While transmitting, RX resumes by itself once the queue drains
+    if (!initialized_ || tx_busy())
     {
         return;
     }
 
-    rx_ready_ = false;
     Radio.Rx(0);
 }
 
 bool RadioStream::available() const
 {
-    return rx_ready_;
+    return rx_pending() > 0;
+}
+
+size_t RadioStream::rx_pending() const
+{
+    return rx_head_.load(std::memory_order_acquire) - rx_tail_.load(std::memory_order_acquire);
+}
+
+uint32_t RadioStream::rx_overflows() const
+{
+    return rx_overflows_.load(std::memory_order_relaxed);
+}
+
+uint32_t RadioStream::rx_errors() const
+{
+    return rx_errors_.load(std::memory_order_relaxed);
 }
 
 size_t RadioStream::read(uint8_t* out, size_t max_length)
 {
-    if (!rx_ready_ || out == nullptr || max_length == 0)
+    if (out == nullptr || max_length == 0)
     {
         return 0;
     }
 
-    size_t to_copy = rx_size_ < max_length ? rx_size_ : max_length;
-    memcpy(out, rx_buffer_, to_copy);
-    rx_ready_ = false;
-    rx_size_ = 0;
+    RxPacket* packet = acquire();
+    if (packet == nullptr)
+    {
+        return 0;
+    }
+
+    size_t to_copy = packet->length < max_length ? packet->length : max_length;
+    memcpy(out, packet->data, to_copy);
+    release();
     return to_copy;
 }
 
+RadioStream::RxPacket* RadioStream::acquire()
+{
+    uint32_t tail = rx_tail_.load(std::memory_order_relaxed);
+    if (rx_head_.load(std::memory_order_acquire) == tail)
+    {
+        return nullptr;
+    }
+
+    RxPacket* packet = &rx_queue_[tail & (kRxQueueDepth - 1)];
+    last_rssi_ = packet->rssi;
+    last_snr_ = packet->snr;
+    return packet;
+}
+
+void RadioStream::release()
+{
+    // The producer never touches the tail slot, so it is ours until now
+    uint32_t tail = rx_tail_.load(std::memory_order_relaxed);
+    if (rx_head_.load(std::memory_order_acquire) != tail)
+    {
+        rx_tail_.store(tail + 1, std::memory_order_release);
+    }
+}
+
 bool RadioStream::tx_busy() const
 {
-    return tx_busy_;
+    return tx_head_ != tx_tail_;
+}
+
+size_t RadioStream::tx_pending() const
+{
+    return tx_head_ - tx_tail_;
 }
 
 bool RadioStream::last_tx_timeout() const
@@ -207,7 +332,22 @@ RadioStream& RadioStream::operator<<(const TxBuffer& buffer)
 
 RadioStream& RadioStream::operator>>(RxBuffer& buffer)
 {
-    buffer.length = read(buffer.data, buffer.max_length);
+    buffer.length = 0;
+    if (buffer.data == nullptr || buffer.max_length == 0)
+    {
+        return *this;
+    }
+
+    RxPacket* packet = acquire();
+    if (packet != nullptr)
+    {
+        buffer.length = packet->length < buffer.max_length ? packet->length : buffer.max_length;
+        memcpy(buffer.data, packet->data, buffer.length);
+        buffer.rssi = packet->rssi;
+        buffer.snr = packet->snr;
+        buffer.timestamp_us = packet->timestamp_us;
+        release();
+    }
     return *this;
 }
 
@@ -224,8 +364,7 @@ void RadioStream::on_tx_done()
 {
     if (instance_ != nullptr)
     {
-        Radio.Sleep();
-        instance_->tx_busy_ = false;
+        instance_->finish_tx(TxStatus::Sent);
     }
 }
 
@@ -233,44 +372,53 @@ void RadioStream::on_tx_timeout()
 {
     if (instance_ != nullptr)
     {
-        Radio.Sleep();
-        instance_->tx_busy_ = false;
-        instance_->last_tx_timeout_ = true;
+        instance_->tx_timeout_sequence_.store(instance_->tx_on_air_.load(std::memory_order_relaxed),
+                                              std::memory_order_relaxed);
+        instance_->tx_timeout_pending_.store(true, std::memory_order_release);
     }
 }
 
 void RadioStream::on_rx_done(uint8_t* payload, uint16_t size, int16_t rssi, int8_t snr)
 {
+    // RX is continuous, so the radio is already listening for the next
+    // packet; just queue this one
     if (instance_ != nullptr)
     {
-        Radio.Sleep();
         instance_->handle_rx_done(payload, size, rssi, snr);
     }
 }
 
 void RadioStream::on_rx_timeout()
 {
-    if (instance_ != nullptr)
-    {
-        Radio.Sleep();
-        instance_->start_rx();
-    }
+    // With Radio.Rx(0) there is no RX timer; this is a header error
+    on_rx_error();
 }
 
 void RadioStream::on_rx_error()
 {
     if (instance_ != nullptr)
     {
-        Radio.Sleep();
-        instance_->start_rx();
+        instance_->rx_errors_.fetch_add(1, std::memory_order_relaxed);
+        instance_->rx_check_pending_.store(true, std::memory_order_release);
     }
 }
 
 void RadioStream::handle_rx_done(uint8_t* payload, uint16_t size, int16_t rssi, int8_t snr)
 {
-    rx_size_ = (size > kBufferSize) ? kBufferSize : size;
-    memcpy(rx_buffer_, payload, rx_size_);
-    last_rssi_ = rssi;
-    last_snr_ = snr;
-    rx_ready_ = true;
+    uint32_t head = rx_head_.load(std::memory_order_relaxed);
+    if (head - rx_tail_.load(std::memory_order_acquire) >= kRxQueueDepth)
+    {
+        rx_overflows_.store(rx_overflows_.load(std::memory_order_relaxed) + 1,
+                            std::memory_order_relaxed);
+        return;
+    }
+
+    RxPacket& packet = rx_queue_[head & (kRxQueueDepth - 1)];
+    packet.length = static_cast<uint8_t>((size > kBufferSize) ? kBufferSize : size);
+    memcpy(packet.data, payload, packet.length);
+    packet.rssi = rssi;
+    packet.snr = snr;
+    packet.timestamp_us = time_us_64();
+
+    rx_head_.store(head + 1, std::memory_order_release);
 }